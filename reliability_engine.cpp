@@ -6,6 +6,61 @@
 #include <random>
 #include <iomanip>
 #include <memory>
+#include <cstdint>
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+#include <string_view>
+#include <cstring>
+#include <limits>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <exception>
+#include <atomic>
+#include <deque>
+#include <array>
+#include <unordered_map>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cstdio>
+#include <cerrno>
+
+#include "reliability_engine.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#define RELIABILITY_HAVE_MMAP 1
+#define RELIABILITY_HAVE_PROCESSES 1
+#endif
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#define RELIABILITY_HAVE_AFFINITY 1
+#endif
+
+// Compact hot record for the fleet scans (see HotRecord): build with
+// -DRELIABILITY_HOT_RECORD=1, and -DRELIABILITY_HOT_HEALTH_BITS=16 for
+// finer health than the default 8 bits
+#ifndef RELIABILITY_HOT_RECORD
+#define RELIABILITY_HOT_RECORD 0
+#endif
+#ifndef RELIABILITY_HOT_HEALTH_BITS
+#define RELIABILITY_HOT_HEALTH_BITS 8
+#endif
+
+#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))
+#include <immintrin.h>
+#endif
 
 // Forward declarations
 class Sensor;
@@ -14,12 +69,38 @@ class ErlangModel;
 class QueueingModel;
 
 // Sensor Type Enumeration
-enum class SensorType {
+enum class SensorType : std::uint8_t {
     TRAFFIC,
     AIR_QUALITY,
     WATER_FLOW
 };
 
+constexpr std::size_t sensorTypeCount = 3;
+
+inline const char* sensorTypeName(SensorType type) {
+    switch(type) {
+        case SensorType::TRAFFIC: return "TRAFFIC";
+        case SensorType::AIR_QUALITY: return "AIR_QUALITY";
+        case SensorType::WATER_FLOW: return "WATER_FLOW";
+        default: return "UNKNOWN";
+    }
+}
+
+// Cascade risk classification
+enum class RiskLevel : std::uint8_t {
+    LOW,
+    MEDIUM,
+    HIGH
+};
+
+inline const char* riskLevelName(RiskLevel level) {
+    switch(level) {
+        case RiskLevel::HIGH: return "HIGH";
+        case RiskLevel::MEDIUM: return "MEDIUM";
+        default: return "LOW";
+    }
+}
+
 // Location Structure
 struct Location {
     double x, y, z;
@@ -58,16 +139,339 @@ public:
     
     void setHealth(double h) { health = h; }
     
-    std::string getTypeString() const {
-        switch(type) {
-            case SensorType::TRAFFIC: return "TRAFFIC";
-            case SensorType::AIR_QUALITY: return "AIR_QUALITY";
-            case SensorType::WATER_FLOW: return "WATER_FLOW";
-            default: return "UNKNOWN";
-        }
+    const char* getTypeString() const {
+        return sensorTypeName(type);
+    }
+};
+
+// Vectorized exp kernels (AVX-512 / AVX2+FMA with a scalar fallback)
+namespace simd {
+
+#if defined(__AVX512F__)
+constexpr std::size_t width = 8;
+#elif defined(__AVX2__) && defined(__FMA__)
+constexpr std::size_t width = 4;
+#else
+constexpr std::size_t width = 1;
+#endif
+
+// exp(x) = 2^n * e^r with n = round(x / ln2), |r| <= ln2/2; e^r from a
+// degree-13 Taylor polynomial, good to ~1 ulp. 2^n is applied as two
+// half-size factors so results near the overflow and subnormal edges stay exact.
+constexpr double expLog2e = 1.4426950408889634074;
+constexpr double expLn2Hi = 6.93147180369123816490e-01;
+constexpr double expLn2Lo = 1.90821492927058770002e-10;
+constexpr double expMin = -745.2;
+constexpr double expMax = 709.79;
+constexpr double expShift = 6755399441055744.0;  // 1.5 * 2^52
+
+constexpr double expCoeffs[14] = {
+    1.0, 1.0, 1.0 / 2, 1.0 / 6, 1.0 / 24, 1.0 / 120, 1.0 / 720,
+    1.0 / 5040, 1.0 / 40320, 1.0 / 362880, 1.0 / 3628800,
+    1.0 / 39916800, 1.0 / 479001600, 1.0 / 6227020800
+};
+
+#if defined(__AVX512F__)
+inline __m512d exp8(__m512d x) {
+    __m512d xc = _mm512_min_pd(_mm512_max_pd(x, _mm512_set1_pd(expMin)),
+                               _mm512_set1_pd(expMax));
+    __m512d n = _mm512_roundscale_pd(_mm512_mul_pd(xc, _mm512_set1_pd(expLog2e)),
+                                     _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m512d r = _mm512_fnmadd_pd(n, _mm512_set1_pd(expLn2Hi), xc);
+    r = _mm512_fnmadd_pd(n, _mm512_set1_pd(expLn2Lo), r);
+    
+    __m512d p = _mm512_set1_pd(expCoeffs[13]);
+    for(int i = 12; i >= 0; --i) {
+        p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(expCoeffs[i]));
+    }
+    
+    __m512d nHalf = _mm512_roundscale_pd(_mm512_mul_pd(n, _mm512_set1_pd(0.5)), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    __m512i bitsLo = _mm512_castpd_si512(
+        _mm512_add_pd(nHalf, _mm512_set1_pd(expShift + 1023.0)));
+    __m512i bitsHi = _mm512_castpd_si512(
+        _mm512_add_pd(_mm512_sub_pd(n, nHalf), _mm512_set1_pd(expShift + 1023.0)));
+    __m512d scaleLo = _mm512_castsi512_pd(_mm512_slli_epi64(bitsLo, 52));
+    __m512d scaleHi = _mm512_castsi512_pd(_mm512_slli_epi64(bitsHi, 52));
+    __m512d result = _mm512_mul_pd(_mm512_mul_pd(p, scaleLo), scaleHi);
+    
+    // Flush true underflow to zero and keep overflow at +inf
+    __mmask8 under = _mm512_cmp_pd_mask(x, _mm512_set1_pd(expMin), _CMP_LT_OQ);
+    __mmask8 over = _mm512_cmp_pd_mask(x, _mm512_set1_pd(expMax), _CMP_GT_OQ);
+    result = _mm512_mask_blend_pd(under, result, _mm512_setzero_pd());
+    return _mm512_mask_blend_pd(over, result, 
+                                _mm512_set1_pd(std::numeric_limits<double>::infinity()));
+}
+#elif defined(__AVX2__) && defined(__FMA__)
+inline __m256d exp4(__m256d x) {
+    __m256d xc = _mm256_min_pd(_mm256_max_pd(x, _mm256_set1_pd(expMin)),
+                               _mm256_set1_pd(expMax));
+    __m256d n = _mm256_round_pd(_mm256_mul_pd(xc, _mm256_set1_pd(expLog2e)),
+                                _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256d r = _mm256_fnmadd_pd(n, _mm256_set1_pd(expLn2Hi), xc);
+    r = _mm256_fnmadd_pd(n, _mm256_set1_pd(expLn2Lo), r);
+    
+    __m256d p = _mm256_set1_pd(expCoeffs[13]);
+    for(int i = 12; i >= 0; --i) {
+        p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(expCoeffs[i]));
+    }
+    
+    __m256d nHalf = _mm256_round_pd(_mm256_mul_pd(n, _mm256_set1_pd(0.5)), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    __m256i bitsLo = _mm256_castpd_si256(
+        _mm256_add_pd(nHalf, _mm256_set1_pd(expShift + 1023.0)));
+    __m256i bitsHi = _mm256_castpd_si256(
+        _mm256_add_pd(_mm256_sub_pd(n, nHalf), _mm256_set1_pd(expShift + 1023.0)));
+    __m256d scaleLo = _mm256_castsi256_pd(_mm256_slli_epi64(bitsLo, 52));
+    __m256d scaleHi = _mm256_castsi256_pd(_mm256_slli_epi64(bitsHi, 52));
+    __m256d result = _mm256_mul_pd(_mm256_mul_pd(p, scaleLo), scaleHi);
+    
+    // Flush true underflow to zero and keep overflow at +inf
+    __m256d under = _mm256_cmp_pd(x, _mm256_set1_pd(expMin), _CMP_LT_OQ);
+    __m256d over = _mm256_cmp_pd(x, _mm256_set1_pd(expMax), _CMP_GT_OQ);
+    result = _mm256_blendv_pd(result, _mm256_setzero_pd(), under);
+    return _mm256_blendv_pd(result, 
+                            _mm256_set1_pd(std::numeric_limits<double>::infinity()), over);
+}
+#endif
+
+// out[i] = exp(x[i]); out may alias x
+inline void expArray(const double* x, std::size_t n, double* out) {
+    std::size_t i = 0;
+#if defined(__AVX512F__)
+    for(; i + 8 <= n; i += 8) {
+        _mm512_storeu_pd(out + i, exp8(_mm512_loadu_pd(x + i)));
+    }
+#elif defined(__AVX2__) && defined(__FMA__)
+    for(; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(out + i, exp4(_mm256_loadu_pd(x + i)));
+    }
+#endif
+    for(; i < n; ++i) {
+        out[i] = std::exp(x[i]);
+    }
+}
+
+// out[i] = exp(-x[i]); out may alias x. 0 - x differs from -x only in the
+// sign of a zero, which exp ignores.
+inline void expNegArray(const double* x, std::size_t n, double* out) {
+    std::size_t i = 0;
+#if defined(__AVX512F__)
+    for(; i + 8 <= n; i += 8) {
+        _mm512_storeu_pd(out + i, exp8(_mm512_sub_pd(_mm512_setzero_pd(), _mm512_loadu_pd(x + i))));
+    }
+#elif defined(__AVX2__) && defined(__FMA__)
+    for(; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(out + i, exp4(_mm256_sub_pd(_mm256_setzero_pd(), _mm256_loadu_pd(x + i))));
+    }
+#endif
+    for(; i < n; ++i) {
+        out[i] = std::exp(-x[i]);
+    }
+}
+
+// log(x) for positive normal x: x = 2^e * m with m in [sqrt(1/2), sqrt(2)),
+// f = m - 1, s = f / (2 + f); log(m) = 2 atanh(s) from the fdlibm
+// log1p-style polynomial in s^2, good to ~1 ulp.
+constexpr double logLn2Hi = 6.93147180369123816490e-01;
+constexpr double logLn2Lo = 1.90821492927058770002e-10;
+constexpr double logSqrt2 = 1.41421356237309504880;
+
+constexpr double logCoeffs[7] = {
+    6.666666666666735130e-01, 3.999999999940941908e-01,
+    2.857142874366239149e-01, 2.222219843214978396e-01,
+    1.818357216161805012e-01, 1.531383769920937332e-01,
+    1.479819860511658591e-01
+};
+
+#if defined(__AVX512F__)
+inline __m512d log8(__m512d x) {
+    // Biased exponent as a double via the 2^52 trick; mantissa forced to [1, 2)
+    __m512i bits = _mm512_castpd_si512(x);
+    __m512i biased = _mm512_or_si512(_mm512_srli_epi64(bits, 52),
+                                     _mm512_set1_epi64(0x4330000000000000LL));
+    __m512d e = _mm512_sub_pd(_mm512_castsi512_pd(biased), 
+                              _mm512_set1_pd(expShift / 1.5 + 1023.0));
+    __m512i mant = _mm512_or_si512(_mm512_and_si512(bits, _mm512_set1_epi64(0x000FFFFFFFFFFFFFLL)),
+                                   _mm512_set1_epi64(0x3FF0000000000000LL));
+    __m512d m = _mm512_castsi512_pd(mant);
+    __mmask8 high = _mm512_cmp_pd_mask(m, _mm512_set1_pd(logSqrt2), _CMP_GT_OQ);
+    m = _mm512_mask_mul_pd(m, high, m, _mm512_set1_pd(0.5));
+    e = _mm512_mask_add_pd(e, high, e, _mm512_set1_pd(1.0));
+    
+    __m512d f = _mm512_sub_pd(m, _mm512_set1_pd(1.0));
+    __m512d s = _mm512_div_pd(f, _mm512_add_pd(f, _mm512_set1_pd(2.0)));
+    __m512d z = _mm512_mul_pd(s, s);
+    __m512d r = _mm512_set1_pd(logCoeffs[6]);
+    for(int i = 5; i >= 0; --i) {
+        r = _mm512_fmadd_pd(r, z, _mm512_set1_pd(logCoeffs[i]));
     }
+    r = _mm512_mul_pd(r, z);
+    
+    __m512d hfsq = _mm512_mul_pd(_mm512_mul_pd(f, f), _mm512_set1_pd(0.5));
+    __m512d t = _mm512_fmadd_pd(s, _mm512_add_pd(hfsq, r), 
+                                _mm512_mul_pd(e, _mm512_set1_pd(logLn2Lo)));
+    return _mm512_fmadd_pd(e, _mm512_set1_pd(logLn2Hi), 
+                           _mm512_sub_pd(f, _mm512_sub_pd(hfsq, t)));
+}
+#elif defined(__AVX2__) && defined(__FMA__)
+inline __m256d log4(__m256d x) {
+    // Biased exponent as a double via the 2^52 trick; mantissa forced to [1, 2)
+    __m256i bits = _mm256_castpd_si256(x);
+    __m256i biased = _mm256_or_si256(_mm256_srli_epi64(bits, 52),
+                                     _mm256_set1_epi64x(0x4330000000000000LL));
+    __m256d e = _mm256_sub_pd(_mm256_castsi256_pd(biased), 
+                              _mm256_set1_pd(expShift / 1.5 + 1023.0));
+    __m256i mant = _mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL)),
+                                   _mm256_set1_epi64x(0x3FF0000000000000LL));
+    __m256d m = _mm256_castsi256_pd(mant);
+    __m256d high = _mm256_cmp_pd(m, _mm256_set1_pd(logSqrt2), _CMP_GT_OQ);
+    m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), high);
+    e = _mm256_add_pd(e, _mm256_and_pd(high, _mm256_set1_pd(1.0)));
+    
+    __m256d f = _mm256_sub_pd(m, _mm256_set1_pd(1.0));
+    __m256d s = _mm256_div_pd(f, _mm256_add_pd(f, _mm256_set1_pd(2.0)));
+    __m256d z = _mm256_mul_pd(s, s);
+    __m256d r = _mm256_set1_pd(logCoeffs[6]);
+    for(int i = 5; i >= 0; --i) {
+        r = _mm256_fmadd_pd(r, z, _mm256_set1_pd(logCoeffs[i]));
+    }
+    r = _mm256_mul_pd(r, z);
+    
+    __m256d hfsq = _mm256_mul_pd(_mm256_mul_pd(f, f), _mm256_set1_pd(0.5));
+    __m256d t = _mm256_fmadd_pd(s, _mm256_add_pd(hfsq, r), 
+                                _mm256_mul_pd(e, _mm256_set1_pd(logLn2Lo)));
+    return _mm256_fmadd_pd(e, _mm256_set1_pd(logLn2Hi), 
+                           _mm256_sub_pd(f, _mm256_sub_pd(hfsq, t)));
+}
+#endif
+
+// out[i] = log(x[i]) for positive normal x; out may alias x
+inline void logArray(const double* x, std::size_t n, double* out) {
+    std::size_t i = 0;
+#if defined(__AVX512F__)
+    for(; i + 8 <= n; i += 8) {
+        _mm512_storeu_pd(out + i, log8(_mm512_loadu_pd(x + i)));
+    }
+#elif defined(__AVX2__) && defined(__FMA__)
+    for(; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(out + i, log4(_mm256_loadu_pd(x + i)));
+    }
+#endif
+    for(; i < n; ++i) {
+        out[i] = std::log(x[i]);
+    }
+}
+
+// Elements processed per stack-resident block in the batch kernels
+constexpr std::size_t blockSize = 256;
+
+} // namespace simd
+
+// Compile-time factorial, reciprocal-factorial and 1/i tables. 170! is the
+// largest factorial representable as a double.
+constexpr int maxTabulatedFactorial = 170;
+
+struct FactorialTables {
+    double factorial[maxTabulatedFactorial + 1];
+    double reciprocalFactorial[maxTabulatedFactorial + 1];
+    double reciprocal[maxTabulatedFactorial + 1];
 };
 
+constexpr FactorialTables makeFactorialTables() {
+    FactorialTables tables{};
+    double result = 1.0;
+    tables.factorial[0] = 1.0;
+    tables.reciprocalFactorial[0] = 1.0;
+    tables.reciprocal[0] = 0.0;
+    for(int i = 1; i <= maxTabulatedFactorial; ++i) {
+        if(i >= 2) result *= i;
+        tables.factorial[i] = result;
+        tables.reciprocalFactorial[i] = 1.0 / result;
+        tables.reciprocal[i] = 1.0 / i;
+    }
+    return tables;
+}
+
+constexpr FactorialTables factorialTables = makeFactorialTables();
+
+inline double factorial(int n) {
+    return (n <= maxTabulatedFactorial) 
+        ? factorialTables.factorial[n < 0 ? 0 : n]
+        : std::numeric_limits<double>::infinity();
+}
+
+inline double reciprocalInteger(int i) {
+    return (i <= maxTabulatedFactorial) ? factorialTables.reciprocal[i] : 1.0 / i;
+}
+
+// x^N with the multiplications unrolled at compile time
+template<int N>
+inline double powInt(double x) {
+    if constexpr (N == 0) {
+        return 1.0;
+    } else if constexpr (N % 2 == 0) {
+        double half = powInt<N / 2>(x);
+        return half * half;
+    } else {
+        return x * powInt<N - 1>(x);
+    }
+}
+
+inline double powInt(double x, int n) {
+    double result = 1.0;
+    while(n > 0) {
+        if(n & 1) result *= x;
+        x *= x;
+        n >>= 1;
+    }
+    return result;
+}
+
+// Points between exact exp() anchors in the curve recurrences
+constexpr std::size_t curveAnchorInterval = 64;
+
+// out[i] = exp(-rate * (t0 + i * dt)) for i in [0, n). Each run of
+// curveAnchorInterval points is one exact exp scaled by precomputed powers
+// of exp(-rate * dt), so error stays within a few ulp for any n.
+inline void decayCurve(double rate, double t0, double dt, std::size_t n, double* out) {
+    double stepPowers[curveAnchorInterval];
+    const double step = std::exp(-rate * dt);
+    stepPowers[0] = 1.0;
+    for(std::size_t j = 1; j < curveAnchorInterval; ++j) {
+        stepPowers[j] = stepPowers[j - 1] * step;
+    }
+    
+    for(std::size_t base = 0; base < n; base += curveAnchorInterval) {
+        std::size_t m = std::min(curveAnchorInterval, n - base);
+        const double anchor = std::exp(-rate * (t0 + base * dt));
+        for(std::size_t j = 0; j < m; ++j) {
+            out[base + j] = anchor * stepPowers[j];
+        }
+    }
+}
+
+// out[i] = R(t0 + i * dt) for an Erlang(k, rate): the decay curve times the
+// truncated series sum_{m<k} x^m / m!, evaluated by Horner per point
+inline void erlangCurve(int k, double rate, double t0, double dt, std::size_t n, 
+                        double* out) {
+    decayCurve(rate, t0, dt, n, out);
+    if(k <= 1) return;
+    
+    double coeffs[maxTabulatedFactorial + 1];
+    const int degree = std::min(k, maxTabulatedFactorial + 1) - 1;
+    for(int m = 0; m <= degree; ++m) {
+        coeffs[m] = factorialTables.reciprocalFactorial[m];
+    }
+    
+    for(std::size_t i = 0; i < n; ++i) {
+        double x = rate * (t0 + i * dt);
+        double p = coeffs[degree];
+        for(int m = degree - 1; m >= 0; --m) {
+            p = p * x + coeffs[m];
+        }
+        out[i] *= p;
+    }
+}
+
 // Exponential Distribution Model
 class ExponentialModel {
 private:
@@ -91,288 +495,7537 @@ public:
     double pdf(double t) const {
         return lambda * std::exp(-lambda * t);
     }
+    
+    // Batch evaluation over an array of time points
+    void reliability(const double* t, std::size_t n, double* out) const {
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = -lambda * t[i];
+        }
+        simd::expArray(out, n, out);
+    }
+    
+    void pdf(const double* t, std::size_t n, double* out) const {
+        reliability(t, n, out);
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] *= lambda;
+        }
+    }
+    
+    void hazardRate(std::size_t n, double* out) const {
+        std::fill(out, out + n, lambda);
+    }
+    
+    // Batch evaluation over an array of failure rates at one time point
+    static void reliabilityBatch(const double* rates, std::size_t n, double t, double* out) {
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = -rates[i] * t;
+        }
+        simd::expArray(out, n, out);
+    }
+    
+    static void pdfBatch(const double* rates, std::size_t n, double t, double* out) {
+        reliabilityBatch(rates, n, t, out);
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] *= rates[i];
+        }
+    }
+    
+    static void hazardBatch(const double* rates, std::size_t n, double* out) {
+        std::copy(rates, rates + n, out);
+    }
+    
+    // R(t0 + i * dt) for i in [0, n) into out, by recurrence
+    void reliabilityCurve(double t0, double dt, std::size_t n, double* out) const {
+        decayCurve(lambda, t0, dt, n, out);
+    }
 };
 
+// Unrolled Erlang series step I..K-1: term *= x / i, sum += term
+template<int I, int K>
+inline void accumulateSeries(double x, double& term, double& sum) {
+    if constexpr (I < K) {
+        term *= x * factorialTables.reciprocal[I];
+        sum += term;
+        accumulateSeries<I + 1, K>(x, term, sum);
+    }
+}
+
 // Erlang Distribution Model
 class ErlangModel {
 private:
     int k;
     double lambda;
+
+    // Series terms e^(-x) x^i / i! for x = lambda * t over one block.
+    // sum receives the first k[j] terms added up, last receives term k[j]-1.
+    static void seriesBlock(const double* x, const int* k, std::size_t m,
+                            double* sum, double* last) {
+        double term[simd::blockSize];
+        int kMax = 1;
+        
+        int kMin = std::numeric_limits<int>::max();
+        
+        for(std::size_t j = 0; j < m; ++j) {
+            kMax = std::max(kMax, k[j]);
+            kMin = std::min(kMin, k[j]);
+        }
+        simd::expNegArray(x, m, term);
+        
+        // Blocks with a single common k take the unmasked, unrolled path
+        if(kMin == kMax) {
+            switch(kMax) {
+                case 1: seriesBlockFixed<1>(x, term, m, sum, last); return;
+                case 2: seriesBlockFixed<2>(x, term, m, sum, last); return;
+                case 3: seriesBlockFixed<3>(x, term, m, sum, last); return;
+                case 4: seriesBlockFixed<4>(x, term, m, sum, last); return;
+                case 5: seriesBlockFixed<5>(x, term, m, sum, last); return;
+                case 6: seriesBlockFixed<6>(x, term, m, sum, last); return;
+                case 7: seriesBlockFixed<7>(x, term, m, sum, last); return;
+                case 8: seriesBlockFixed<8>(x, term, m, sum, last); return;  // maxSpecializedStages
+                default: break;
+            }
+        }
+        
+        for(std::size_t j = 0; j < m; ++j) {
+            sum[j] = term[j];
+            last[j] = term[j];
+        }
+        
+        for(int i = 1; i < kMax; ++i) {
+            const double inv = reciprocalInteger(i);
+            for(std::size_t j = 0; j < m; ++j) {
+                term[j] *= x[j] * inv;
+                bool active = i < k[j];
+                sum[j] += active ? term[j] : 0.0;
+                last[j] = active ? term[j] : last[j];
+            }
+        }
+    }
     
-    double factorial(int n) const {
-        double result = 1.0;
-        for(int i = 2; i <= n; ++i) {
-            result *= i;
+    // term holds e^(-x) on entry
+    template<int K>
+    static void seriesBlockFixed(const double* x, double* term, std::size_t m,
+                                 double* sum, double* last) {
+        for(std::size_t j = 0; j < m; ++j) {
+            double t = term[j];
+            double acc = t;
+            accumulateSeries<1, K>(x[j], t, acc);
+            sum[j] = acc;
+            last[j] = t;
+        }
+    }
+    
+    enum class BatchOutput { RELIABILITY, PDF, HAZARD };
+    
+    static void evaluateBlock(const double* x, const int* k, const double* rates,
+                              double rate, std::size_t m, BatchOutput what,
+                              double* out) {
+        double last[simd::blockSize];
+        seriesBlock(x, k, m, out, last);
+        
+        if(what == BatchOutput::PDF) {
+            for(std::size_t j = 0; j < m; ++j) {
+                out[j] = (rates ? rates[j] : rate) * last[j];
+            }
+        } else if(what == BatchOutput::HAZARD) {
+            for(std::size_t j = 0; j < m; ++j) {
+                out[j] = (rates ? rates[j] : rate) * last[j] / out[j];
+            }
+        }
+    }
+    
+    static void evaluatePairs(const int* stages, const double* rates, std::size_t n,
+                              double t, BatchOutput what, double* out) {
+        double x[simd::blockSize];
+        
+        for(std::size_t base = 0; base < n; base += simd::blockSize) {
+            std::size_t m = std::min(simd::blockSize, n - base);
+            for(std::size_t j = 0; j < m; ++j) {
+                x[j] = rates[base + j] * t;
+            }
+            evaluateBlock(x, stages + base, rates + base, 0.0, m, what, out + base);
+        }
+    }
+    
+    void evaluateTimes(const double* t, std::size_t n, BatchOutput what, 
+                       double* out) const {
+        double x[simd::blockSize];
+        int stages[simd::blockSize];
+        std::fill(stages, stages + simd::blockSize, k);
+        
+        for(std::size_t base = 0; base < n; base += simd::blockSize) {
+            std::size_t m = std::min(simd::blockSize, n - base);
+            for(std::size_t j = 0; j < m; ++j) {
+                x[j] = lambda * t[base + j];
+            }
+            evaluateBlock(x, stages, nullptr, lambda, m, what, out + base);
         }
-        return result;
     }
 
 public:
     ErlangModel(int stages, double rate) : k(stages), lambda(rate) {}
     
     double reliability(double t) const {
-        // R(t) = 1 - CDF(t)
-        double cdf = 0.0;
+        // R(t) = 1 - CDF(t) = sum_{i<k} e^(-lambda t) (lambda t)^i / i!
+        double survival = 0.0;
         double term = std::exp(-lambda * t);
         
         for(int i = 0; i < k; ++i) {
             if(i > 0) {
-                term *= (lambda * t) / i;
+                term *= (lambda * t) * reciprocalInteger(i);
             }
-            cdf += term;
+            survival += term;
         }
         
-        return 1.0 - cdf;
+        return survival;
     }
     
     double pdf(double t) const {
-        return (std::pow(lambda, k) * std::pow(t, k - 1) * 
-                std::exp(-lambda * t)) / factorial(k - 1);
+        // f(t) = lambda e^(-x) x^(k-1) / (k-1)!, x = lambda t
+        double x = lambda * t;
+        double inverseFact = (k >= 1 && k - 1 <= maxTabulatedFactorial)
+            ? factorialTables.reciprocalFactorial[k - 1]
+            : 1.0 / factorial(k - 1);
+        return lambda * powInt(x, k - 1) * std::exp(-x) * inverseFact;
+    }
+    
+    double hazardRate(double t) const {
+        return pdf(t) / reliability(t);
     }
     
     double mttf() const {
         return static_cast<double>(k) / lambda;
     }
+    
+    // Batch evaluation over an array of time points
+    void reliability(const double* t, std::size_t n, double* out) const {
+        evaluateTimes(t, n, BatchOutput::RELIABILITY, out);
+    }
+    
+    void pdf(const double* t, std::size_t n, double* out) const {
+        evaluateTimes(t, n, BatchOutput::PDF, out);
+    }
+    
+    void hazardRate(const double* t, std::size_t n, double* out) const {
+        evaluateTimes(t, n, BatchOutput::HAZARD, out);
+    }
+    
+    // R(t0 + i * dt) for i in [0, n) into out, by recurrence
+    void reliabilityCurve(double t0, double dt, std::size_t n, double* out) const {
+        erlangCurve(k, lambda, t0, dt, n, out);
+    }
+    
+    // Batch evaluation over arrays of (k, lambda) pairs at one time point
+    static void reliabilityBatch(const int* stages, const double* rates, std::size_t n,
+                                 double t, double* out) {
+        evaluatePairs(stages, rates, n, t, BatchOutput::RELIABILITY, out);
+    }
+    
+    static void pdfBatch(const int* stages, const double* rates, std::size_t n,
+                         double t, double* out) {
+        evaluatePairs(stages, rates, n, t, BatchOutput::PDF, out);
+    }
+    
+    static void hazardBatch(const int* stages, const double* rates, std::size_t n,
+                            double t, double* out) {
+        evaluatePairs(stages, rates, n, t, BatchOutput::HAZARD, out);
+    }
 };
 
-// Queueing Theory M/M/c Model
-class QueueingModel {
+// Largest stage count with a compile-time specialized batch kernel
+constexpr int maxSpecializedStages = 8;
+
+// Erlang model with the stage count fixed at compile time, so the CDF series
+// and the pdf power are fully unrolled
+template<int K>
+class FixedErlangModel {
+    static_assert(K >= 1 && K <= maxTabulatedFactorial, "stage count out of table range");
+    
 private:
-    double arrivalRate;
-    double serviceRate;
-    int numServers;
-    double rho;
+    double lambda;
+
+public:
+    explicit FixedErlangModel(double rate) : lambda(rate) {}
     
-    double factorial(int n) const {
-        double result = 1.0;
-        for(int i = 2; i <= n; ++i) {
-            result *= i;
-        }
-        return result;
+    static constexpr int stages() { return K; }
+    
+    double reliability(double t) const {
+        double x = lambda * t;
+        double term = std::exp(-x);
+        double sum = term;
+        accumulateSeries<1, K>(x, term, sum);
+        return sum;
     }
     
-    double calculateP0() const {
-        double lambdaMu = arrivalRate / serviceRate;
-        double sumTerm = 0.0;
-        
-        for(int n = 0; n < numServers; ++n) {
-            sumTerm += std::pow(lambdaMu, n) / factorial(n);
-        }
-        
-        double lastTerm = std::pow(lambdaMu, numServers) / 
-                         (factorial(numServers) * (1.0 - rho));
-        
-        return 1.0 / (sumTerm + lastTerm);
+    double pdf(double t) const {
+        double x = lambda * t;
+        return lambda * powInt<K - 1>(x) * std::exp(-x) * 
+               factorialTables.reciprocalFactorial[K - 1];
     }
-
-public:
-    QueueingModel(double arrival, double service, int servers)
-        : arrivalRate(arrival), serviceRate(service), numServers(servers) {
-        rho = arrivalRate / (numServers * serviceRate);
+    
+    double hazardRate(double t) const {
+        return pdf(t) / reliability(t);
     }
     
-    bool isStable() const {
-        return rho < 1.0;
+    double mttf() const {
+        return static_cast<double>(K) / lambda;
     }
     
-    double getUtilization() const {
-        return rho;
+    void reliabilityCurve(double t0, double dt, std::size_t n, double* out) const {
+        erlangCurve(K, lambda, t0, dt, n, out);
     }
     
-    double avgQueueLength() const {
-        if(!isStable()) return -1.0;
-        
-        double p0 = calculateP0();
-        double lambdaMu = arrivalRate / serviceRate;
-        
-        return (p0 * std::pow(lambdaMu, numServers) * rho) /
-               (factorial(numServers) * std::pow(1.0 - rho, 2));
+    // Batch evaluation over an array of time points
+    void reliability(const double* t, std::size_t n, double* out) const {
+        double x[simd::blockSize];
+        for(std::size_t base = 0; base < n; base += simd::blockSize) {
+            std::size_t m = std::min(simd::blockSize, n - base);
+            for(std::size_t j = 0; j < m; ++j) {
+                x[j] = lambda * t[base + j];
+                out[base + j] = -x[j];
+            }
+            simd::expArray(out + base, m, out + base);
+            for(std::size_t j = 0; j < m; ++j) {
+                double term = out[base + j];
+                double sum = term;
+                accumulateSeries<1, K>(x[j], term, sum);
+                out[base + j] = sum;
+            }
+        }
     }
     
-    double avgWaitTime() const {
-        if(!isStable()) return -1.0;
-        
-        double lq = avgQueueLength();
-        return (arrivalRate > 0) ? lq / arrivalRate : 0.0;
+    // Batch evaluation over an array of rates at one time point; matches
+    // ErlangModel::reliabilityBatch with every stage count equal to K
+    static void reliabilityBatch(const double* rates, std::size_t n, double t, double* out) {
+        double x[simd::blockSize];
+        for(std::size_t base = 0; base < n; base += simd::blockSize) {
+            std::size_t m = std::min(simd::blockSize, n - base);
+            for(std::size_t j = 0; j < m; ++j) {
+                x[j] = rates[base + j] * t;
+                out[base + j] = -x[j];
+            }
+            simd::expArray(out + base, m, out + base);
+            for(std::size_t j = 0; j < m; ++j) {
+                double term = out[base + j];
+                double sum = term;
+                accumulateSeries<1, K>(x[j], term, sum);
+                out[base + j] = sum;
+            }
+        }
     }
 };
 
-// Fleet Reliability Manager
-class FleetReliabilityManager {
+// u[j] = u[j]^shape over one block, as exp(shape * log u), with the shape
+// per element when shapes is non-null. u <= 0 gives 0; u below the smallest
+// normal double is clamped to it for the vector log.
+inline void powBlock(double* u, std::size_t m, const double* shapes, double shape) {
+    bool zero[simd::blockSize];
+    for(std::size_t j = 0; j < m; ++j) {
+        zero[j] = !(u[j] > 0.0);
+        u[j] = zero[j] ? 1.0 : std::max(u[j], std::numeric_limits<double>::min());
+    }
+    simd::logArray(u, m, u);
+    for(std::size_t j = 0; j < m; ++j) {
+        u[j] *= shapes ? shapes[j] : shape;
+    }
+    simd::expArray(u, m, u);
+    for(std::size_t j = 0; j < m; ++j) {
+        u[j] = zero[j] ? 0.0 : u[j];
+    }
+}
+
+// Weibull Distribution Model: R(t) = exp(-(t / scale)^shape). Shape below 1
+// gives a falling hazard (infant mortality), 1 is exponential with rate
+// 1/scale, above 1 is wear-out.
+class WeibullModel {
 private:
-    std::vector<std::shared_ptr<Sensor>> sensors;
-    std::vector<std::unique_ptr<ExponentialModel>> exponentialModels;
-    std::vector<std::unique_ptr<ErlangModel>> erlangModels;
+    double beta;
+    double eta;
 
 public:
-    void addSensor(std::shared_ptr<Sensor> sensor) {
-        sensors.push_back(sensor);
-        
-        exponentialModels.push_back(
-            std::make_unique<ExponentialModel>(sensor->getFailureRate())
-        );
-        
-        erlangModels.push_back(
-            std::make_unique<ErlangModel>(sensor->getKStages(), sensor->getFailureRate())
-        );
+    WeibullModel(double shape, double scale) : beta(shape), eta(scale) {}
+    
+    double shape() const { return beta; }
+    double scale() const { return eta; }
+    
+    double cumulativeHazard(double t) const {
+        return t > 0.0 ? std::pow(t / eta, beta) : 0.0;
     }
     
-    double calculateFleetMTBF() const {
-        double sum = 0.0;
-        for(const auto& model : exponentialModels) {
-            sum += model->mtbf();
-        }
-        return sum / exponentialModels.size();
+    double reliability(double t) const {
+        return std::exp(-cumulativeHazard(t));
     }
     
-    double calculateFleetMTTF() const {
-        double sum = 0.0;
-        for(const auto& model : erlangModels) {
-            sum += model->mttf();
-        }
-        return sum / erlangModels.size();
+    double hazardRate(double t) const {
+        return beta / eta * std::pow(std::max(t, 0.0) / eta, beta - 1.0);
     }
     
-    double calculateFleetReliability(double timeHorizon) const {
-        double sum = 0.0;
-        for(const auto& model : erlangModels) {
-            sum += model->reliability(timeHorizon);
-        }
-        return sum / erlangModels.size();
+    double pdf(double t) const {
+        return hazardRate(t) * reliability(t);
     }
     
-    struct SensorStats {
-        int total;
-        int active;
-        int warning;
-        int failed;
-    };
+    double mttf() const {
+        return eta * std::tgamma(1.0 + 1.0 / beta);
+    }
     
-    SensorStats getSensorStats() const {
-        SensorStats stats = {0, 0, 0, 0};
-        stats.total = sensors.size();
-        
-        for(const auto& sensor : sensors) {
-            double health = sensor->getHealth();
-            if(health > 70.0) {
-                stats.active++;
-            } else if(health > 30.0) {
-                stats.warning++;
-            } else {
-                stats.failed++;
+    // Batch cumulative hazard over an array of time points
+    void cumulativeHazard(const double* t, std::size_t n, double* out) const {
+        for(std::size_t base = 0; base < n; base += simd::blockSize) {
+            std::size_t m = std::min(simd::blockSize, n - base);
+            for(std::size_t j = 0; j < m; ++j) {
+                out[base + j] = t[base + j] / eta;
             }
+            powBlock(out + base, m, nullptr, beta);
         }
-        
-        return stats;
     }
     
-    struct CascadeRisk {
-        int currentFailures;
-        double riskFactor;
-        int expectedAdditional;
-        std::string riskLevel;
-        double dependencyMultiplier;
-    };
+    void reliability(const double* t, std::size_t n, double* out) const {
+        cumulativeHazard(t, n, out);
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = -out[i];
+        }
+        simd::expArray(out, n, out);
+    }
     
-    CascadeRisk analyzeCascadeRisk() const {
-        CascadeRisk risk;
-        risk.currentFailures = 0;
-        
-        for(const auto& sensor : sensors) {
-            if(sensor->getHealth() < 30.0) {
-                risk.currentFailures++;
+    // Batch evaluation over arrays of (shape, scale) pairs at one time point
+    static void reliabilityBatch(const double* shapes, const double* scales, std::size_t n,
+                                 double t, double* out) {
+        for(std::size_t base = 0; base < n; base += simd::blockSize) {
+            std::size_t m = std::min(simd::blockSize, n - base);
+            for(std::size_t j = 0; j < m; ++j) {
+                out[base + j] = t / scales[base + j];
             }
+            powBlock(out + base, m, shapes + base, 0.0);
+            for(std::size_t j = 0; j < m; ++j) {
+                out[base + j] = -out[base + j];
+            }
+            simd::expArray(out + base, m, out + base);
         }
-        
-        risk.riskFactor = static_cast<double>(risk.currentFailures) / sensors.size();
-        
-        if(risk.riskFactor > 0.2) {
-            risk.dependencyMultiplier = 1.5;
-        } else if(risk.riskFactor > 0.1) {
-            risk.dependencyMultiplier = 1.2;
-        } else {
+    }
+    
+    void reliabilityCurve(double t0, double dt, std::size_t n, double* out) const {
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = t0 + i * dt;
+        }
+        reliability(out, n, out);
+    }
+};
+
+// Competing-risk model: independent Weibull failure modes, the unit failing
+// at the first of them. Hazards add, so R(t) = exp(-sum H_i(t)); infant
+// mortality, random and wear-out modes together give a bathtub hazard.
+class CompetingRiskModel {
+private:
+    std::vector<WeibullModel> modes;
+
+public:
+    CompetingRiskModel() = default;
+    explicit CompetingRiskModel(std::vector<WeibullModel> failureModes)
+        : modes(std::move(failureModes)) {}
+    
+    // Bathtub curve from an infant-mortality (shape < 1), a constant-rate
+    // and a wear-out (shape > 1) mode
+    static CompetingRiskModel bathtub(double infantShape, double infantScale, double randomRate,
+                                      double wearShape, double wearScale) {
+        return CompetingRiskModel({WeibullModel(infantShape, infantScale),
+                                   WeibullModel(1.0, 1.0 / randomRate),
+                                   WeibullModel(wearShape, wearScale)});
+    }
+    
+    const std::vector<WeibullModel>& components() const { return modes; }
+    
+    double cumulativeHazard(double t) const {
+        double total = 0.0;
+        for(const auto& mode : modes) {
+            total += mode.cumulativeHazard(t);
+        }
+        return total;
+    }
+    
+    double reliability(double t) const {
+        return std::exp(-cumulativeHazard(t));
+    }
+    
+    double hazardRate(double t) const {
+        double total = 0.0;
+        for(const auto& mode : modes) {
+            total += mode.hazardRate(t);
+        }
+        return total;
+    }
+    
+    double pdf(double t) const {
+        return hazardRate(t) * reliability(t);
+    }
+    
+    // Batch evaluation over an array of time points: the per-mode hazards
+    // are summed block by block, then one vector exp
+    void reliability(const double* t, std::size_t n, double* out) const {
+        double u[simd::blockSize];
+        for(std::size_t base = 0; base < n; base += simd::blockSize) {
+            std::size_t m = std::min(simd::blockSize, n - base);
+            std::fill(out + base, out + base + m, 0.0);
+            for(const auto& mode : modes) {
+                for(std::size_t j = 0; j < m; ++j) {
+                    u[j] = t[base + j] / mode.scale();
+                }
+                powBlock(u, m, nullptr, mode.shape());
+                for(std::size_t j = 0; j < m; ++j) {
+                    out[base + j] -= u[j];
+                }
+            }
+            simd::expArray(out + base, m, out + base);
+        }
+    }
+    
+    void reliabilityCurve(double t0, double dt, std::size_t n, double* out) const {
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = t0 + i * dt;
+        }
+        reliability(out, n, out);
+    }
+};
+
+// Engine instrumentation: per-API call, work and latency counters, pulled
+// with EngineMetrics::collect() or as Prometheus text. The O(1) aggregate
+// queries (fleet and per-type MTBF, MTTF, sensor stats, cascade risk) take
+// a few ns, less than any probe would need to stay under 1%, so they are
+// not instrumented. Build with -DRELIABILITY_NO_METRICS to compile every
+// probe out.
+#ifndef RELIABILITY_NO_METRICS
+#define RELIABILITY_HAVE_METRICS 1
+#endif
+
+enum class MetricApi : std::uint8_t {
+    FLEET_RELIABILITY,
+    FLEET_RELIABILITY_REGION,
+    FLEET_RELIABILITY_CURVE,
+    FLEET_SNAPSHOT,
+    FLEET_RELIABILITY_TYPE,
+    FLEET_TYPE_SNAPSHOTS,
+    SENSOR_STATS_REGION,
+    CASCADE_RISK_REGION,
+    CASCADE_PROPAGATION,
+    QUEUE_METRICS,
+    QUEUE_SWEEP_SERVERS,
+    QUEUE_SWEEP_ARRIVALS,
+    QUEUE_MINIMUM_SERVERS,
+    HEALTH_HISTORY,
+    TOP_K_AT_RISK,
+    FLEET_SUMMARY,
+    SCENARIO_SWEEP,
+    COUNT
+};
+
+constexpr std::size_t metricApiCount = static_cast<std::size_t>(MetricApi::COUNT);
+
+constexpr const char* metricApiNames[metricApiCount] = {
+    "fleet_reliability",
+    "fleet_reliability_region",
+    "fleet_reliability_curve",
+    "fleet_snapshot",
+    "fleet_reliability_type",
+    "fleet_type_snapshots",
+    "sensor_stats_region",
+    "cascade_risk_region",
+    "cascade_propagation",
+    "queue_metrics",
+    "queue_sweep_servers",
+    "queue_sweep_arrivals",
+    "queue_minimum_servers",
+    "health_history",
+    "top_k_at_risk",
+    "fleet_summary",
+    "scenario_sweep",
+};
+
+// A timed call of d ns leaves the next probeTimingBudget / d calls untimed,
+// so two clock reads (~20-80 ns) stay near 1% of the time they measure.
+// Calls of 8 us or longer are timed every time.
+constexpr std::uint64_t probeTimingBudget = 8192;
+constexpr std::uint32_t probeMaxSkip = 4095;
+
+// HDR-style log-linear latency buckets in nanoseconds: exact below 16 ns,
+// then 16 sub-buckets per power of two (<= 6.25% relative width) up to
+// 2^47 ns (~39 hours); anything longer lands in the last bucket.
+constexpr int latencySubBucketBits = 4;
+constexpr std::size_t latencySubBuckets = std::size_t(1) << latencySubBucketBits;
+constexpr int latencyMaxExponent = 47;
+constexpr std::size_t latencyBuckets = 
+    latencySubBuckets * (latencyMaxExponent - latencySubBucketBits + 2);
+
+inline std::size_t latencyBucket(std::uint64_t nanos) {
+    if(nanos < latencySubBuckets) return static_cast<std::size_t>(nanos);
+    int e = 63 - __builtin_clzll(nanos);
+    std::size_t bucket = (e - latencySubBucketBits + 1) * latencySubBuckets + 
+                         ((nanos >> (e - latencySubBucketBits)) & (latencySubBuckets - 1));
+    return std::min(bucket, latencyBuckets - 1);
+}
+
+// Smallest latency that maps to bucket b
+inline std::uint64_t latencyBucketLower(std::size_t b) {
+    if(b < latencySubBuckets) return b;
+    int e = static_cast<int>(b / latencySubBuckets) + latencySubBucketBits - 1;
+    std::uint64_t mantissa = latencySubBuckets + b % latencySubBuckets;
+    return mantissa << (e - latencySubBucketBits);
+}
+
+// Totals for one probe. processed counts sensors visited by fleet queries
+// and Erlang B recurrence steps (servers) by queueing calls. The latency
+// histogram holds the timed calls only.
+struct ApiMetrics {
+    const char* name = "";
+    std::uint64_t calls = 0;
+    std::uint64_t processed = 0;
+    std::uint64_t timedCalls = 0;
+    std::uint64_t timedNanos = 0;
+    std::array<std::uint64_t, latencyBuckets> latency{};
+    
+    double meanNanos() const {
+        return timedCalls ? static_cast<double>(timedNanos) / timedCalls : 0.0;
+    }
+    
+    // Upper edge of the bucket holding the q-quantile of timed calls
+    double quantileNanos(double q) const {
+        if(timedCalls == 0) return 0.0;
+        std::uint64_t target = static_cast<std::uint64_t>(std::ceil(q * timedCalls));
+        target = std::max<std::uint64_t>(target, 1);
+        std::uint64_t seen = 0;
+        for(std::size_t b = 0; b < latencyBuckets; ++b) {
+            seen += latency[b];
+            if(seen >= target) {
+                return static_cast<double>(b + 1 < latencyBuckets ? latencyBucketLower(b + 1) 
+                                                                  : latencyBucketLower(b));
+            }
+        }
+        return static_cast<double>(latencyBucketLower(latencyBuckets - 1));
+    }
+};
+
+struct MetricsSnapshot {
+    std::array<ApiMetrics, metricApiCount> apis;
+    
+    const ApiMetrics& operator[](MetricApi api) const {
+        return apis[static_cast<std::size_t>(api)];
+    }
+};
+
+#ifdef RELIABILITY_HAVE_METRICS
+// Per-thread probe counters. Only the owning thread writes them (plain
+// relaxed load + store, no locked instruction); collectors read them
+// relaxed, so a pull never blocks or slows the hot path.
+struct alignas(64) MetricsShard {
+    struct Counters {
+        std::atomic<std::uint64_t> calls{0};
+        std::atomic<std::uint64_t> processed{0};
+        std::atomic<std::uint64_t> timedCalls{0};
+        std::atomic<std::uint64_t> timedNanos{0};
+        std::array<std::atomic<std::uint64_t>, latencyBuckets> latency{};
+        std::uint32_t skip = 0;  // untimed calls left; owner thread only
+    };
+    std::array<Counters, metricApiCount> apis;
+    
+    static void bump(std::atomic<std::uint64_t>& counter, std::uint64_t by) {
+        counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+    
+    void addTo(MetricsSnapshot& out) const {
+        for(std::size_t a = 0; a < metricApiCount; ++a) {
+            const Counters& c = apis[a];
+            ApiMetrics& m = out.apis[a];
+            m.calls += c.calls.load(std::memory_order_relaxed);
+            m.processed += c.processed.load(std::memory_order_relaxed);
+            m.timedCalls += c.timedCalls.load(std::memory_order_relaxed);
+            m.timedNanos += c.timedNanos.load(std::memory_order_relaxed);
+            for(std::size_t b = 0; b < latencyBuckets; ++b) {
+                m.latency[b] += c.latency[b].load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    void clear() {
+        for(Counters& c : apis) {
+            c.calls.store(0, std::memory_order_relaxed);
+            c.processed.store(0, std::memory_order_relaxed);
+            c.timedCalls.store(0, std::memory_order_relaxed);
+            c.timedNanos.store(0, std::memory_order_relaxed);
+            for(auto& bucket : c.latency) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+            c.skip = 0;
+        }
+    }
+};
+
+// Registry of live shards. A thread's shard is attached on its first probe;
+// on thread exit its counts fold into the retired totals and the shard is
+// recycled for the next new thread.
+class EngineMetrics {
+private:
+    std::mutex mutex;
+    std::vector<std::unique_ptr<MetricsShard>> shards;
+    std::vector<MetricsShard*> live;
+    std::vector<MetricsShard*> spare;
+    MetricsSnapshot retired;
+    MetricsSnapshot baseline;
+    
+    struct Lease {
+        MetricsShard* shard = nullptr;
+        ~Lease() {
+            if(shard) instance().release(shard);
+        }
+    };
+    
+    static EngineMetrics& instance() {
+        static EngineMetrics* metrics = new EngineMetrics();  // outlives thread exits
+        return *metrics;
+    }
+    
+    static MetricsShard*& current() {
+        static thread_local MetricsShard* shard = nullptr;
+        return shard;
+    }
+    
+    MetricsShard* acquire() {
+        std::lock_guard<std::mutex> lock(mutex);
+        MetricsShard* shard;
+        if(!spare.empty()) {
+            shard = spare.back();
+            spare.pop_back();
+        } else {
+            shards.push_back(std::make_unique<MetricsShard>());
+            shard = shards.back().get();
+        }
+        live.push_back(shard);
+        return shard;
+    }
+    
+    void release(MetricsShard* shard) {
+        std::lock_guard<std::mutex> lock(mutex);
+        shard->addTo(retired);
+        shard->clear();
+        live.erase(std::find(live.begin(), live.end(), shard));
+        spare.push_back(shard);
+    }
+    
+    MetricsSnapshot totals() {
+        MetricsSnapshot out = retired;
+        for(const MetricsShard* shard : live) {
+            shard->addTo(out);
+        }
+        return out;
+    }
+    
+    __attribute__((noinline)) static MetricsShard& attach() {
+        static thread_local Lease lease;
+        lease.shard = instance().acquire();
+        current() = lease.shard;
+        return *lease.shard;
+    }
+
+public:
+    static constexpr bool enabled = true;
+    
+    static MetricsShard& shard() {
+        MetricsShard* s = current();
+        return __builtin_expect(s != nullptr, 1) ? *s : attach();
+    }
+    
+    // Counts since the last reset(), summed over all threads
+    static MetricsSnapshot collect() {
+        EngineMetrics& m = instance();
+        std::lock_guard<std::mutex> lock(m.mutex);
+        MetricsSnapshot out = m.totals();
+        for(std::size_t a = 0; a < metricApiCount; ++a) {
+            ApiMetrics& api = out.apis[a];
+            const ApiMetrics& base = m.baseline.apis[a];
+            api.name = metricApiNames[a];
+            api.calls -= base.calls;
+            api.processed -= base.processed;
+            api.timedCalls -= base.timedCalls;
+            api.timedNanos -= base.timedNanos;
+            for(std::size_t b = 0; b < latencyBuckets; ++b) {
+                api.latency[b] -= base.latency[b];
+            }
+        }
+        return out;
+    }
+    
+    // Restart the counts; exact even while other threads keep probing
+    static void reset() {
+        EngineMetrics& m = instance();
+        std::lock_guard<std::mutex> lock(m.mutex);
+        m.baseline = m.totals();
+    }
+};
+
+// Counts one API call and, unless it falls in a skip run, times it until
+// scope exit. The untimed path is inlined into the caller (a few
+// instructions, ~0.3 ns); clock reads and histogram updates stay out of line.
+class ApiProbe {
+private:
+    MetricsShard::Counters& counters;
+    std::uint64_t processed;
+    std::chrono::steady_clock::time_point start;
+    bool timed;
+    
+    __attribute__((noinline, cold)) void startClock() {
+        start = std::chrono::steady_clock::now();
+    }
+    
+    __attribute__((noinline, cold)) void stopClock() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        std::uint64_t nanos = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        MetricsShard::bump(counters.timedCalls, 1);
+        MetricsShard::bump(counters.timedNanos, nanos);
+        MetricsShard::bump(counters.latency[latencyBucket(nanos)], 1);
+        counters.skip = static_cast<std::uint32_t>(
+            std::min<std::uint64_t>(probeTimingBudget / std::max<std::uint64_t>(nanos, 1), probeMaxSkip));
+    }
+
+public:
+    __attribute__((always_inline)) ApiProbe(MetricApi api, std::uint64_t work = 0)
+        : counters(EngineMetrics::shard().apis[static_cast<std::size_t>(api)]), processed(work) {
+        MetricsShard::bump(counters.calls, 1);
+        timed = counters.skip == 0;
+        if(__builtin_expect(timed, 0)) {
+            startClock();
+        } else {
+            --counters.skip;
+        }
+    }
+    
+    ApiProbe(const ApiProbe&) = delete;
+    ApiProbe& operator=(const ApiProbe&) = delete;
+    
+    // For work only known once the call has run (e.g. region sizes)
+    void setProcessed(std::uint64_t work) {
+        processed = work;
+    }
+    
+    __attribute__((always_inline)) ~ApiProbe() {
+        if(processed) MetricsShard::bump(counters.processed, processed);
+        if(__builtin_expect(timed, 0)) stopClock();
+    }
+};
+#else
+class EngineMetrics {
+public:
+    static constexpr bool enabled = false;
+    
+    static MetricsSnapshot collect() {
+        MetricsSnapshot out;
+        for(std::size_t a = 0; a < metricApiCount; ++a) {
+            out.apis[a].name = metricApiNames[a];
+        }
+        return out;
+    }
+    
+    static void reset() {}
+};
+
+class ApiProbe {
+public:
+    explicit ApiProbe(MetricApi, std::uint64_t = 0) {}
+    void setProcessed(std::uint64_t) {}
+};
+#endif
+
+// Prometheus text exposition of a metrics snapshot. Latency buckets are
+// exported at power-of-two edges from 128 ns to ~34 s, in seconds.
+inline void writePrometheus(std::ostream& out, const MetricsSnapshot& metrics) {
+    out << "# HELP reliability_api_calls_total Engine API calls.\n"
+        << "# TYPE reliability_api_calls_total counter\n";
+    for(const ApiMetrics& m : metrics.apis) {
+        out << "reliability_api_calls_total{api=\"" << m.name << "\"} " << m.calls << '\n';
+    }
+    out << "# HELP reliability_api_processed_total Sensors (fleet APIs) or servers "
+           "(queueing APIs) processed.\n"
+        << "# TYPE reliability_api_processed_total counter\n";
+    for(const ApiMetrics& m : metrics.apis) {
+        out << "reliability_api_processed_total{api=\"" << m.name << "\"} " << m.processed << '\n';
+    }
+    out << "# HELP reliability_api_latency_seconds Latency of timed engine API calls.\n"
+        << "# TYPE reliability_api_latency_seconds histogram\n";
+    char edge[32];
+    for(const ApiMetrics& m : metrics.apis) {
+        std::uint64_t cumulative = 0;
+        std::size_t b = 0;
+        for(int e = 7; e <= 35; ++e) {
+            const std::size_t end = latencyBucket(std::uint64_t(1) << e);
+            for(; b < end; ++b) {
+                cumulative += m.latency[b];
+            }
+            std::snprintf(edge, sizeof(edge), "%.9g", std::ldexp(1e-9, e));
+            out << "reliability_api_latency_seconds_bucket{api=\"" << m.name 
+                << "\",le=\"" << edge << "\"} " << cumulative << '\n';
+        }
+        std::snprintf(edge, sizeof(edge), "%.9g", m.timedNanos * 1e-9);
+        out << "reliability_api_latency_seconds_bucket{api=\"" << m.name << "\",le=\"+Inf\"} " 
+            << m.timedCalls << '\n'
+            << "reliability_api_latency_seconds_sum{api=\"" << m.name << "\"} " << edge << '\n'
+            << "reliability_api_latency_seconds_count{api=\"" << m.name << "\"} " 
+            << m.timedCalls << '\n';
+    }
+}
+
+inline void writePrometheus(std::ostream& out) {
+    writePrometheus(out, EngineMetrics::collect());
+}
+
+// Queueing Theory M/M/c Model
+// Steady-state M/M/c metrics for one (arrival rate, server count) pair
+struct QueueMetrics {
+    int servers;
+    double arrivalRate;
+    double utilization;
+    double waitProbability;   // Erlang C
+    double avgQueueLength;    // -1 when unstable
+    double avgWaitTime;       // -1 when unstable
+};
+
+// M/M/c via the Erlang B recurrence B(0) = 1, B(k) = a B / (k + a B) with
+// offered load a = lambda / mu. Every step stays in [0, 1], so it neither
+// overflows nor cancels, and is O(c) without pow or factorials. Erlang C
+// follows as c B / (c - a (1 - B)).
+class QueueingModel {
+private:
+    double arrivalRate;
+    double serviceRate;
+    int numServers;
+    double rho;
+    
+    static double erlangBRecurrence(double load, int servers) {
+        double b = 1.0;
+        for(int k = 1; k <= servers; ++k) {
+            b = load * b / (k + load * b);
+        }
+        return b;
+    }
+    
+    static double erlangCFromB(double b, double load, int servers) {
+        return servers * b / (servers - load * (1.0 - b));
+    }
+    
+    static QueueMetrics metricsFrom(double arrival, double service, int servers, double erlangB) {
+        QueueMetrics m;
+        double load = arrival / service;
+        m.servers = servers;
+        m.arrivalRate = arrival;
+        m.utilization = (servers > 0) ? load / servers : std::numeric_limits<double>::infinity();
+        if(m.utilization < 1.0) {
+            m.waitProbability = erlangCFromB(erlangB, load, servers);
+            m.avgQueueLength = m.waitProbability * m.utilization / (1.0 - m.utilization);
+            m.avgWaitTime = (arrival > 0) ? m.avgQueueLength / arrival : 0.0;
+        } else {
+            m.waitProbability = 1.0;
+            m.avgQueueLength = -1.0;
+            m.avgWaitTime = -1.0;
+        }
+        return m;
+    }
+
+    // Unprobed, so each public getter counts as one call
+    QueueMetrics evaluate() const {
+        return metricsFrom(arrivalRate, serviceRate, numServers,
+                           erlangBRecurrence(arrivalRate / serviceRate, numServers));
+    }
+
+public:
+    QueueingModel(double arrival, double service, int servers)
+        : arrivalRate(arrival), serviceRate(service), numServers(servers) {
+        rho = arrivalRate / (numServers * serviceRate);
+    }
+    
+    bool isStable() const {
+        return rho < 1.0;
+    }
+    
+    double getUtilization() const {
+        return rho;
+    }
+    
+    // Blocking probability of the loss system M/M/c/c
+    double erlangB() const {
+        ApiProbe probe(MetricApi::QUEUE_METRICS, std::max(numServers, 0));
+        return erlangBRecurrence(arrivalRate / serviceRate, numServers);
+    }
+    
+    // Probability an arriving job has to wait
+    double erlangC() const {
+        ApiProbe probe(MetricApi::QUEUE_METRICS, std::max(numServers, 0));
+        return evaluate().waitProbability;
+    }
+    
+    double avgQueueLength() const {
+        ApiProbe probe(MetricApi::QUEUE_METRICS, std::max(numServers, 0));
+        return evaluate().avgQueueLength;
+    }
+    
+    double avgWaitTime() const {
+        ApiProbe probe(MetricApi::QUEUE_METRICS, std::max(numServers, 0));
+        return evaluate().avgWaitTime;
+    }
+    
+    QueueMetrics metrics() const {
+        ApiProbe probe(MetricApi::QUEUE_METRICS, std::max(numServers, 0));
+        return evaluate();
+    }
+    
+    // Metrics for every server count in [minServers, maxServers]; one O(maxServers)
+    // recurrence pass serves the whole sweep. minServers >= 1; out holds
+    // maxServers - minServers + 1 entries.
+    static void sweepServers(double arrival, double service, int minServers, int maxServers,
+                             QueueMetrics* out) {
+        ApiProbe probe(MetricApi::QUEUE_SWEEP_SERVERS, std::max(maxServers, 0));
+        double load = arrival / service;
+        double b = 1.0;
+        for(int k = 1; k <= maxServers; ++k) {
+            b = load * b / (k + load * b);
+            if(k >= minServers) {
+                out[k - minServers] = metricsFrom(arrival, service, k, b);
+            }
+        }
+    }
+    
+    // Metrics at each arrival rate for a fixed crew size, O(n * servers)
+    static void sweepArrivals(const double* arrivals, std::size_t n, double service, 
+                              int servers, QueueMetrics* out) {
+        ApiProbe probe(MetricApi::QUEUE_SWEEP_ARRIVALS, n * std::max(servers, 0));
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = metricsFrom(arrivals[i], service, servers,
+                                 erlangBRecurrence(arrivals[i] / service, servers));
+        }
+    }
+    
+    // Smallest server count whose mean wait is at most targetWait; the
+    // recurrence is extended one server at a time, so the cost is O(answer)
+    static int minimumServers(double arrival, double service, double targetWait,
+                              int maxServers = std::numeric_limits<int>::max()) {
+        ApiProbe probe(MetricApi::QUEUE_MINIMUM_SERVERS);
+        double load = arrival / service;
+        double b = 1.0;
+        for(int k = 1; k <= maxServers; ++k) {
+            b = load * b / (k + load * b);
+            QueueMetrics m = metricsFrom(arrival, service, k, b);
+            if(m.avgWaitTime >= 0.0 && m.avgWaitTime <= targetWait) {
+                probe.setProcessed(k);
+                return k;
+            }
+        }
+        probe.setProcessed(std::max(maxServers, 0));
+        return -1;
+    }
+};
+
+// Cache-line aligned allocator for fleet columns
+template<typename T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+    
+    template<typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+    
+    AlignedAllocator() noexcept = default;
+    
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+    
+    T* allocate(std::size_t n) {
+        std::size_t bytes = (n * sizeof(T) + Alignment - 1) / Alignment * Alignment;
+        void* p = std::aligned_alloc(Alignment, bytes);
+        if(!p) throw std::bad_alloc();
+        return static_cast<T*>(p);
+    }
+    
+    void deallocate(T* p, std::size_t) noexcept {
+        std::free(p);
+    }
+    
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+    
+    template<typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+template<typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+// Aligned allocator whose resize leaves new elements default-initialized
+// (uninitialized for plain data), so a page is first touched, and placed on
+// a NUMA node, by whichever thread first writes it
+template<typename T>
+struct ColumnAllocator : AlignedAllocator<T> {
+    template<typename U>
+    struct rebind { using other = ColumnAllocator<U>; };
+    
+    ColumnAllocator() noexcept = default;
+    
+    template<typename U>
+    ColumnAllocator(const ColumnAllocator<U>&) noexcept {}
+    
+    template<typename U>
+    void construct(U* p) {
+        ::new (static_cast<void*>(p)) U;
+    }
+    
+    template<typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+};
+
+template<typename T>
+using ColumnVector = std::vector<T, ColumnAllocator<T>>;
+
+// Bump allocator for short-lived scratch memory. Blocks are 64-byte aligned
+// and kept across rewinds, so a steady query load stops calling the global
+// allocator once the arena has grown to its working size. Not thread-safe;
+// use one arena per thread (see scratch()).
+class MonotonicArena {
+private:
+    struct Block {
+        char* data;
+        std::size_t size;
+    };
+    
+    std::vector<Block> blocks;
+    std::size_t current = 0;
+    std::size_t offset = 0;
+    std::size_t initialSize;
+
+public:
+    struct Mark {
+        std::size_t block;
+        std::size_t offset;
+    };
+    
+    explicit MonotonicArena(std::size_t initial = 64 * 1024) : initialSize(initial) {}
+    
+    ~MonotonicArena() {
+        for(const auto& b : blocks) std::free(b.data);
+    }
+    
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+    
+    void* allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t)) {
+        for(; current < blocks.size(); ++current, offset = 0) {
+            std::size_t start = (offset + align - 1) & ~(align - 1);
+            if(start + bytes <= blocks[current].size) {
+                offset = start + bytes;
+                return blocks[current].data + start;
+            }
+        }
+        
+        // Grow geometrically; an oversized request gets a block of its own
+        std::size_t last = blocks.empty() ? initialSize : blocks.back().size * 2;
+        std::size_t size = (std::max(last, bytes + align) + 63) / 64 * 64;
+        char* data = static_cast<char*>(std::aligned_alloc(64, size));
+        if(!data) throw std::bad_alloc();
+        blocks.push_back({data, size});
+        current = blocks.size() - 1;
+        offset = bytes;
+        return data;
+    }
+    
+    template<typename T>
+    T* allocateArray(std::size_t n) {
+        return static_cast<T*>(allocate(n * sizeof(T), std::max<std::size_t>(alignof(T), 64)));
+    }
+    
+    Mark mark() const {
+        return {current, offset};
+    }
+    
+    // Release everything allocated after m; blocks are kept for reuse
+    void rewind(Mark m) {
+        current = m.block;
+        offset = m.offset;
+    }
+    
+    std::size_t capacity() const {
+        std::size_t total = 0;
+        for(const auto& b : blocks) total += b.size;
+        return total;
+    }
+    
+    // Per-thread scratch arena for query temporaries
+    static MonotonicArena& scratch() {
+        static thread_local MonotonicArena arena;
+        return arena;
+    }
+};
+
+// Rewinds the calling thread's scratch arena on scope exit; scopes nest
+class ArenaScope {
+private:
+    MonotonicArena& arena;
+    MonotonicArena::Mark start;
+
+public:
+    ArenaScope() : arena(MonotonicArena::scratch()), start(arena.mark()) {}
+    ~ArenaScope() { arena.rewind(start); }
+    
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+    
+    MonotonicArena& get() { return arena; }
+};
+
+// STL adaptor over the scratch arena; deallocation is a no-op until the
+// enclosing ArenaScope rewinds
+template<typename T>
+struct ArenaAllocator {
+    using value_type = T;
+    
+    MonotonicArena* arena;
+    
+    ArenaAllocator() noexcept : arena(&MonotonicArena::scratch()) {}
+    
+    explicit ArenaAllocator(MonotonicArena& a) noexcept : arena(&a) {}
+    
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.arena) {}
+    
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+    
+    void deallocate(T*, std::size_t) noexcept {}
+    
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena == other.arena; }
+    
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return arena != other.arena; }
+};
+
+template<typename T>
+using ScratchVector = std::vector<T, ArenaAllocator<T>>;
+
+// Column-oriented view of a batch of sensor records, as decoded from the
+// binary ingest format. IDs are idLengths[i] bytes each, packed in idBytes.
+struct SensorChunk {
+    std::size_t count;
+    const double* health;
+    const double* uptimeHours;
+    const double* failureRate;
+    const double* locX;
+    const double* locY;
+    const double* locZ;
+    const std::uint8_t* kStages;
+    const std::uint8_t* types;
+    const std::uint16_t* queuePositions;
+    const std::uint8_t* idLengths;
+    const char* idBytes;
+    
+    // Why the records cannot be inserted, or nullptr when all are valid
+    const char* validate() const {
+        for(std::size_t i = 0; i < count; ++i) {
+            if(types[i] >= sensorTypeCount) return "unknown sensor type";
+            if(kStages[i] == 0) return "zero Erlang stages";
+        }
+        return nullptr;
+    }
+};
+
+// 8-byte copy of the fields the reliability scans read, kept beside the
+// full-precision columns in RELIABILITY_HOT_RECORD builds: rate as float,
+// stage count as uint8 (at most 255) and health in fixed point (0.5 steps
+// in 8 bits, 1/512 in 16). Scans then stream 8 bytes per sensor instead of
+// 20. Their results carry float rounding; the columns stay exact.
+struct HotRecord {
+#if RELIABILITY_HOT_HEALTH_BITS == 16
+    using Health = std::uint16_t;
+    static constexpr double healthScale = 512.0;
+#else
+    using Health = std::uint8_t;
+    static constexpr double healthScale = 2.0;
+#endif
+    
+    float failureRate;
+    Health health;
+    std::uint8_t kStages;
+    
+    // Rounded up, so the > 70 and > 30 bucket tests on the quantized value
+    // match the exact ones; only cascade's < 30 can miss values within one
+    // step below 30
+    static Health quantizeHealth(double h) {
+        constexpr double top = std::numeric_limits<Health>::max();
+        const double q = std::ceil(h * healthScale);
+        return static_cast<Health>(q > 0.0 ? std::min(q, top) : 0.0);
+    }
+    
+    double getHealth() const {
+        return health / healthScale;
+    }
+    
+    static HotRecord pack(double health, double rate, int k) {
+        return {static_cast<float>(rate), quantizeHealth(health),
+                static_cast<std::uint8_t>(std::min(std::max(k, 0), 255))};
+    }
+};
+
+static_assert(sizeof(HotRecord) == 8, "hot record must stay one 8-byte word");
+constexpr bool hotRecordEnabled = RELIABILITY_HOT_RECORD != 0;
+
+// Read-only view of the fleet columns, backed either by a FleetStore or by
+// a memory-mapped snapshot. mtbf/mttf are optional precomputed 1/lambda and
+// k/lambda columns (nullptr when absent), and hot is the store's HotRecord
+// array in RELIABILITY_HOT_RECORD builds. Sensors are partitioned by type:
+// type t occupies slots [typeBegin[t], typeBegin[t + 1]).
+struct FleetColumns {
+    std::size_t count = 0;
+    std::array<std::size_t, sensorTypeCount + 1> typeBegin{};
+    const double* health = nullptr;
+    const double* failureRate = nullptr;
+    const int* kStages = nullptr;
+    const double* uptimeHours = nullptr;
+    const SensorType* types = nullptr;
+    const double* locX = nullptr;
+    const double* locY = nullptr;
+    const double* locZ = nullptr;
+    const int* queuePositions = nullptr;
+    const double* mtbf = nullptr;
+    const double* mttf = nullptr;
+    const HotRecord* hot = nullptr;
+    const std::uint32_t* idStart = nullptr;
+    const std::uint32_t* idLength = nullptr;
+    const char* idPool = nullptr;
+    
+    std::string_view getId(std::size_t i) const {
+        return std::string_view(idPool + idStart[i], idLength[i]);
+    }
+    
+    Location getLocation(std::size_t i) const {
+        return Location(locX[i], locY[i], locZ[i]);
+    }
+    
+    Sensor getSensor(std::size_t i) const {
+        return Sensor(std::string(getId(i)), types[i], getLocation(i), health[i],
+                      uptimeHours[i], failureRate[i], kStages[i], queuePositions[i]);
+    }
+    
+    std::size_t typeBeginOf(SensorType t) const {
+        return typeBegin[static_cast<std::size_t>(t)];
+    }
+    
+    std::size_t typeEndOf(SensorType t) const {
+        return typeBegin[static_cast<std::size_t>(t) + 1];
+    }
+};
+
+// Structure-of-arrays fleet store: one contiguous column per sensor field,
+// with the sensors of each type in one contiguous slot range (in SensorType
+// order). Keeping the ranges packed means an insert or removal shifts at
+// most one boundary sensor per later type; every such move is reported to
+// the caller's moved(from, to) so slot-indexed side structures can follow.
+class FleetStore {
+private:
+    // Every resize is followed by writes to the new slots, so the columns
+    // skip zero-filling (see place())
+    ColumnVector<double> health;
+    ColumnVector<double> failureRate;
+    ColumnVector<int> kStages;
+    ColumnVector<double> uptimeHours;
+    ColumnVector<SensorType> types;
+    ColumnVector<double> locX;
+    ColumnVector<double> locY;
+    ColumnVector<double> locZ;
+    ColumnVector<int> queuePositions;
+    ColumnVector<HotRecord> hot;        // empty unless hotRecordEnabled
+    
+    // Sensor IDs packed into one character pool; removed IDs leave dead
+    // bytes behind until the pool is compacted
+    std::vector<char> idPool;
+    std::vector<std::uint32_t> idStart;
+    std::vector<std::uint32_t> idLength;
+    std::size_t deadIdBytes = 0;
+    
+    std::array<std::size_t, sensorTypeCount + 1> typeBegin{};
+    
+    void resize(std::size_t n) {
+        health.resize(n);
+        failureRate.resize(n);
+        kStages.resize(n);
+        uptimeHours.resize(n);
+        types.resize(n);
+        locX.resize(n);
+        locY.resize(n);
+        locZ.resize(n);
+        queuePositions.resize(n);
+        if(hotRecordEnabled) hot.resize(n);
+        idStart.resize(n);
+        idLength.resize(n);
+    }
+    
+    // Copy the record in slot from over slot to
+    void moveRecord(std::size_t from, std::size_t to) {
+        health[to] = health[from];
+        failureRate[to] = failureRate[from];
+        kStages[to] = kStages[from];
+        uptimeHours[to] = uptimeHours[from];
+        types[to] = types[from];
+        locX[to] = locX[from];
+        locY[to] = locY[from];
+        locZ[to] = locZ[from];
+        queuePositions[to] = queuePositions[from];
+        if(hotRecordEnabled) hot[to] = hot[from];
+        idStart[to] = idStart[from];
+        idLength[to] = idLength[from];
+    }
+    
+    void writeRecord(std::size_t i, std::string_view id, SensorType type, const Location& loc,
+                     double health_, double uptime, double rate, int k, int qPos) {
+        health[i] = health_;
+        failureRate[i] = rate;
+        kStages[i] = k;
+        uptimeHours[i] = uptime;
+        types[i] = type;
+        locX[i] = loc.x;
+        locY[i] = loc.y;
+        locZ[i] = loc.z;
+        queuePositions[i] = qPos;
+        if(hotRecordEnabled) hot[i] = HotRecord::pack(health_, rate, k);
+        idStart[i] = static_cast<std::uint32_t>(idPool.size());
+        idLength[i] = static_cast<std::uint32_t>(id.size());
+        idPool.insert(idPool.end(), id.begin(), id.end());
+    }
+    
+    void compactIds() {
+        std::vector<char> packed;
+        packed.reserve(idPool.size() - deadIdBytes);
+        for(std::size_t i = 0; i < idStart.size(); ++i) {
+            std::uint32_t start = static_cast<std::uint32_t>(packed.size());
+            packed.insert(packed.end(), idPool.begin() + idStart[i],
+                          idPool.begin() + idStart[i] + idLength[i]);
+            idStart[i] = start;
+        }
+        idPool.swap(packed);
+        deadIdBytes = 0;
+    }
+
+public:
+    std::size_t size() const { return health.size(); }
+    bool empty() const { return health.empty(); }
+    
+    // Bytes allocated for the columns and ID pool (capacity, not size)
+    std::size_t memoryBytes() const {
+        return health.capacity() * sizeof(double) + failureRate.capacity() * sizeof(double) +
+               kStages.capacity() * sizeof(int) + uptimeHours.capacity() * sizeof(double) +
+               types.capacity() * sizeof(SensorType) + locX.capacity() * sizeof(double) +
+               locY.capacity() * sizeof(double) + locZ.capacity() * sizeof(double) +
+               queuePositions.capacity() * sizeof(int) + hot.capacity() * sizeof(HotRecord) +
+               idPool.capacity() +
+               idStart.capacity() * sizeof(std::uint32_t) + 
+               idLength.capacity() * sizeof(std::uint32_t);
+    }
+    
+    // Capacity for n sensors and idBytes bytes of packed IDs
+    void reserve(std::size_t n, std::size_t idBytes = 0) {
+        idPool.reserve(idBytes);
+        health.reserve(n);
+        failureRate.reserve(n);
+        kStages.reserve(n);
+        uptimeHours.reserve(n);
+        types.reserve(n);
+        locX.reserve(n);
+        locY.reserve(n);
+        locZ.reserve(n);
+        queuePositions.reserve(n);
+        if(hotRecordEnabled) hot.reserve(n);
+        idStart.reserve(n);
+        idLength.reserve(n);
+    }
+    
+    // Insert at the end of the type's range; returns the new slot. Each
+    // later non-empty range moves its first sensor to its end.
+    template<typename MoveFn>
+    std::size_t add(std::string_view id, SensorType type, const Location& loc,
+                    double health_, double uptime, double rate, int k, int qPos,
+                    MoveFn&& moved) {
+        const std::size_t t = static_cast<std::size_t>(type);
+        std::size_t hole = size();
+        resize(hole + 1);
+        for(std::size_t u = sensorTypeCount - 1; u > t; --u) {
+            const std::size_t begin = typeBegin[u]++;
+            if(begin != hole) {
+                moveRecord(begin, hole);
+                moved(begin, hole);
+                hole = begin;
+            }
+        }
+        ++typeBegin[sensorTypeCount];
+        writeRecord(hole, id, type, loc, health_, uptime, rate, k, qPos);
+        return hole;
+    }
+    
+    // Insert a whole chunk (types below sensorTypeCount), each sensor at the
+    // end of its type's range in chunk order. Range u shifts right by the number of new sensors of
+    // earlier types, moving at most that many of its sensors; new slots are
+    // reported to added(slot) once all moves are done.
+    template<typename MoveFn, typename AddFn>
+    void append(const SensorChunk& chunk, MoveFn&& moved, AddFn&& added) {
+        const std::size_t n = size();
+        const std::size_t m = chunk.count;
+        
+        std::array<std::size_t, sensorTypeCount> incoming{};
+        std::size_t idTotal = 0;
+        for(std::size_t i = 0; i < m; ++i) {
+            ++incoming[chunk.types[i]];
+            idTotal += chunk.idLengths[i];
+        }
+        std::array<std::size_t, sensorTypeCount + 1> shift{};
+        for(std::size_t u = 0; u < sensorTypeCount; ++u) {
+            shift[u + 1] = shift[u] + incoming[u];
+        }
+        
+        resize(n + m);
+        const auto old = typeBegin;
+        std::array<std::size_t, sensorTypeCount> tail{};
+        for(std::size_t u = sensorTypeCount; u-- > 0;) {
+            const std::size_t begin = old[u];
+            const std::size_t length = old[u + 1] - begin;
+            const std::size_t by = shift[u];
+            const std::size_t moves = std::min(by, length);
+            const std::size_t target = begin + std::max(by, length);
+            for(std::size_t j = 0; j < moves; ++j) {
+                moveRecord(begin + j, target + j);
+                moved(begin + j, target + j);
+            }
+            typeBegin[u] = begin + by;
+            tail[u] = begin + by + length;
+        }
+        typeBegin[sensorTypeCount] = n + m;
+        
+        if(idPool.capacity() < idPool.size() + idTotal) {
+            idPool.reserve(std::max(idPool.size() + idTotal, idPool.capacity() * 2));
+        }
+        std::size_t idOffset = 0;
+        for(std::size_t i = 0; i < m; ++i) {
+            const std::size_t u = chunk.types[i];
+            std::string_view id(chunk.idBytes + idOffset, chunk.idLengths[i]);
+            idOffset += chunk.idLengths[i];
+            writeRecord(tail[u]++, id, static_cast<SensorType>(u),
+                        Location(chunk.locX[i], chunk.locY[i], chunk.locZ[i]),
+                        chunk.health[i], chunk.uptimeHours[i], chunk.failureRate[i],
+                        chunk.kStages[i], chunk.queuePositions[i]);
+        }
+        for(std::size_t u = 0; u < sensorTypeCount; ++u) {
+            for(std::size_t slot = tail[u] - incoming[u]; slot < tail[u]; ++slot) {
+                added(slot);
+            }
+        }
+    }
+    
+    // Remove slot i: the last sensor of its type fills the gap, then each
+    // later non-empty range moves its last sensor down into the slot freed
+    // before it
+    template<typename MoveFn>
+    void remove(std::size_t i, MoveFn&& moved) {
+        const std::size_t t = static_cast<std::size_t>(types[i]);
+        deadIdBytes += idLength[i];
+        
+        std::size_t hole = i;
+        const std::size_t lastOfType = typeBegin[t + 1] - 1;
+        if(hole != lastOfType) {
+            moveRecord(lastOfType, hole);
+            moved(lastOfType, hole);
+            hole = lastOfType;
+        }
+        for(std::size_t u = t + 1; u < sensorTypeCount; ++u) {
+            const std::size_t end = typeBegin[u + 1];
+            --typeBegin[u];
+            if(end > hole + 1) {
+                moveRecord(end - 1, hole);
+                moved(end - 1, hole);
+                hole = end - 1;
+            }
+        }
+        --typeBegin[sensorTypeCount];
+        resize(size() - 1);
+        
+        if(deadIdBytes > 4096 && deadIdBytes * 2 > idPool.size()) {
+            compactIds();
+        }
+    }
+    
+    std::size_t typeBeginOf(SensorType t) const {
+        return typeBegin[static_cast<std::size_t>(t)];
+    }
+    
+    std::size_t typeEndOf(SensorType t) const {
+        return typeBegin[static_cast<std::size_t>(t) + 1];
+    }
+    
+    std::string_view getId(std::size_t i) const {
+        return std::string_view(idPool.data() + idStart[i], idLength[i]);
+    }
+    
+    Location getLocation(std::size_t i) const {
+        return Location(locX[i], locY[i], locZ[i]);
+    }
+    
+    double getHealth(std::size_t i) const { return health[i]; }
+    double getUptime(std::size_t i) const { return uptimeHours[i]; }
+    double getFailureRate(std::size_t i) const { return failureRate[i]; }
+    int getKStages(std::size_t i) const { return kStages[i]; }
+    SensorType getType(std::size_t i) const { return types[i]; }
+    int getQueuePosition(std::size_t i) const { return queuePositions[i]; }
+    
+    void setHealth(std::size_t i, double h) {
+        health[i] = h;
+        if(hotRecordEnabled) hot[i].health = HotRecord::quantizeHealth(h);
+    }
+    
+    // Materialize a standalone Sensor object for slot i
+    Sensor getSensor(std::size_t i) const {
+        return columns().getSensor(i);
+    }
+    
+    FleetColumns columns() const {
+        FleetColumns c;
+        c.count = size();
+        c.typeBegin = typeBegin;
+        c.health = health.data();
+        c.failureRate = failureRate.data();
+        c.kStages = kStages.data();
+        c.uptimeHours = uptimeHours.data();
+        c.types = types.data();
+        c.locX = locX.data();
+        c.locY = locY.data();
+        c.locZ = locZ.data();
+        c.queuePositions = queuePositions.data();
+        c.hot = hotRecordEnabled ? hot.data() : nullptr;
+        c.idStart = idStart.data();
+        c.idLength = idLength.data();
+        c.idPool = idPool.data();
+        return c;
+    }
+    
+    // Replace the contents with a copy of any (type-partitioned) column view
+    void assign(const FleetColumns& c) {
+        typeBegin = c.typeBegin;
+        health.assign(c.health, c.health + c.count);
+        failureRate.assign(c.failureRate, c.failureRate + c.count);
+        kStages.assign(c.kStages, c.kStages + c.count);
+        uptimeHours.assign(c.uptimeHours, c.uptimeHours + c.count);
+        types.assign(c.types, c.types + c.count);
+        locX.assign(c.locX, c.locX + c.count);
+        locY.assign(c.locY, c.locY + c.count);
+        locZ.assign(c.locZ, c.locZ + c.count);
+        queuePositions.assign(c.queuePositions, c.queuePositions + c.count);
+        if(hotRecordEnabled) {
+            hot.resize(c.count);
+            for(std::size_t i = 0; i < c.count; ++i) {
+                hot[i] = HotRecord::pack(c.health[i], c.failureRate[i], c.kStages[i]);
+            }
+        }
+        idStart.clear();
+        idLength.clear();
+        idPool.clear();
+        for(std::size_t i = 0; i < c.count; ++i) {
+            std::string_view id = c.getId(i);
+            idStart.push_back(static_cast<std::uint32_t>(idPool.size()));
+            idLength.push_back(static_cast<std::uint32_t>(id.size()));
+            idPool.insert(idPool.end(), id.begin(), id.end());
+        }
+        deadIdBytes = 0;
+    }
+    
+    std::size_t capacity() const { return health.capacity(); }
+    
+    // Move the scanned columns into fresh allocations whose pages are first
+    // touched by forChunks(count, body), which runs body(c) for every chunk
+    // of chunkSlots slots on the NUMA node that owns it. Spare capacity is
+    // touched too, so later appends land on the owning node. Returns the
+    // number of chunks placed.
+    template<typename ForChunks>
+    std::size_t place(std::size_t chunkSlots, ForChunks&& forChunks) {
+        const std::size_t n = size();
+        const std::size_t slots = std::max(n, capacity());
+        const std::size_t chunks = (slots + chunkSlots - 1) / chunkSlots;
+        if(chunks == 0) return 0;
+        
+        auto fresh = [slots](const auto& column) {
+            std::decay_t<decltype(column)> placed;
+            placed.resize(slots);
+            return placed;
+        };
+        auto placedHealth = fresh(health);
+        auto placedRate = fresh(failureRate);
+        auto placedStages = fresh(kStages);
+        auto placedUptime = fresh(uptimeHours);
+        auto placedTypes = fresh(types);
+        auto placedX = fresh(locX);
+        auto placedY = fresh(locY);
+        auto placedZ = fresh(locZ);
+        auto placedQueue = fresh(queuePositions);
+        auto placedHot = hotRecordEnabled ? fresh(hot) : ColumnVector<HotRecord>();
+        
+        forChunks(chunks, [&](std::size_t c) {
+            const std::size_t begin = c * chunkSlots;
+            const std::size_t end = std::min(slots, begin + chunkSlots);
+            const std::size_t live = std::min(std::max(begin, n), end);
+            auto fill = [begin, end, live](auto& to, const auto& from) {
+                std::copy(from.begin() + begin, from.begin() + live, to.begin() + begin);
+                std::fill(to.begin() + live, to.begin() + end,
+                          typename std::decay_t<decltype(to)>::value_type{});
+            };
+            fill(placedHealth, health);
+            fill(placedRate, failureRate);
+            fill(placedStages, kStages);
+            fill(placedUptime, uptimeHours);
+            fill(placedTypes, types);
+            fill(placedX, locX);
+            fill(placedY, locY);
+            fill(placedZ, locZ);
+            fill(placedQueue, queuePositions);
+            if(hotRecordEnabled) fill(placedHot, hot);
+        });
+        
+        auto adopt = [n](auto& column, auto& placed) {
+            placed.resize(n);
+            column.swap(placed);
+        };
+        adopt(health, placedHealth);
+        adopt(failureRate, placedRate);
+        adopt(kStages, placedStages);
+        adopt(uptimeHours, placedUptime);
+        adopt(types, placedTypes);
+        adopt(locX, placedX);
+        adopt(locY, placedY);
+        adopt(locZ, placedZ);
+        adopt(queuePositions, placedQueue);
+        if(hotRecordEnabled) adopt(hot, placedHot);
+        return chunks;
+    }
+    
+    // Raw column access for linear scans
+    const double* healthData() const { return health.data(); }
+    const double* failureRateData() const { return failureRate.data(); }
+    const int* kStagesData() const { return kStages.data(); }
+    const double* uptimeData() const { return uptimeHours.data(); }
+    const SensorType* typeData() const { return types.data(); }
+    const double* locXData() const { return locX.data(); }
+    const double* locYData() const { return locY.data(); }
+    const double* locZData() const { return locZ.data(); }
+};
+
+// Open-addressing (linear probing) index from sensor ID to dense slot. The
+// IDs themselves stay interned in the fleet's packed ID pool; buckets hold
+// the ID hash and slot, so probes compare strings only on a hash match.
+struct IdIndexBucket {
+    std::uint32_t hash;
+    std::uint32_t slot;
+};
+
+class SensorIdIndex {
+private:
+    static constexpr std::uint32_t emptySlot = 0xFFFFFFFFu;
+    
+    std::vector<IdIndexBucket> owned;
+    const IdIndexBucket* table = nullptr;
+    std::size_t capacity = 0;
+    std::size_t used = 0;
+    
+    std::size_t mask() const { return capacity - 1; }
+    
+    void grow() {
+        rehash(std::max<std::size_t>(16, capacity * 2));
+    }
+    
+    void rehash(std::size_t newCapacity) {
+        std::vector<IdIndexBucket> old;
+        old.swap(owned);
+        owned.assign(newCapacity, IdIndexBucket{0, emptySlot});
+        table = owned.data();
+        capacity = newCapacity;
+        for(const auto& b : old) {
+            if(b.slot != emptySlot) place(b);
+        }
+    }
+    
+    void place(IdIndexBucket entry) {
+        std::size_t i = entry.hash & mask();
+        while(owned[i].slot != emptySlot) {
+            i = (i + 1) & mask();
+        }
+        owned[i] = entry;
+    }
+    
+    std::size_t findBucket(std::uint32_t hash, std::uint32_t slot) const {
+        for(std::size_t i = hash & mask(); ; i = (i + 1) & mask()) {
+            if(table[i].slot == slot) return i;
+            if(table[i].slot == emptySlot) return capacity;
+        }
+    }
+
+public:
+    static std::uint32_t hashId(std::string_view id) {
+        // 64-bit FNV-1a folded to 32 bits
+        std::uint64_t h = 1469598103934665603ull;
+        for(char c : id) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 1099511628211ull;
+        }
+        return static_cast<std::uint32_t>(h ^ (h >> 32));
+    }
+    
+    static std::size_t capacityFor(std::size_t n) {
+        std::size_t cap = 16;
+        while(cap * 7 < n * 10) cap *= 2;
+        return cap;
+    }
+    
+    // Whether a foreign table indexing n slots keeps every lookup in bounds
+    // and terminating: a power-of-two size at the load factor's capacity,
+    // at most n occupied buckets, each naming a slot below n
+    static bool isValidTable(const IdIndexBucket* buckets, std::size_t bucketCount, std::size_t n) {
+        if(bucketCount < capacityFor(n) || (bucketCount & (bucketCount - 1)) != 0) return false;
+        std::size_t occupied = 0;
+        for(std::size_t i = 0; i < bucketCount; ++i) {
+            if(buckets[i].slot == emptySlot) continue;
+            if(buckets[i].slot >= n || ++occupied > n) return false;
+        }
+        return true;
+    }
+    
+    void clear() {
+        owned.clear();
+        table = nullptr;
+        capacity = 0;
+        used = 0;
+    }
+    
+    // Size the owned table for n entries so inserts up to n never rehash
+    void reserve(std::size_t n) {
+        if(isAttached()) return;
+        std::size_t needed = capacityFor(n);
+        if(needed > capacity) rehash(needed);
+    }
+    
+    // Use an externally owned (e.g. memory-mapped) table read-only
+    void attach(const IdIndexBucket* buckets, std::size_t bucketCount, std::size_t entries) {
+        owned.clear();
+        table = buckets;
+        capacity = bucketCount;
+        used = entries;
+    }
+    
+    bool isAttached() const {
+        return table && owned.empty();
+    }
+    
+    std::size_t memoryBytes() const {
+        return owned.capacity() * sizeof(IdIndexBucket);
+    }
+    
+    void rebuild(const FleetColumns& c) {
+        clear();
+        capacity = capacityFor(c.count);
+        owned.assign(capacity, IdIndexBucket{0, emptySlot});
+        table = owned.data();
+        for(std::size_t i = 0; i < c.count; ++i) {
+            place({hashId(c.getId(i)), static_cast<std::uint32_t>(i)});
+        }
+        used = c.count;
+    }
+    
+    void insert(std::string_view id, std::size_t slot) {
+        if((used + 1) * 10 > capacity * 7) grow();
+        place({hashId(id), static_cast<std::uint32_t>(slot)});
+        ++used;
+    }
+    
+    // Backward-shift deletion keeps probe chains intact without tombstones
+    void erase(std::string_view id, std::size_t slot) {
+        std::size_t i = findBucket(hashId(id), static_cast<std::uint32_t>(slot));
+        if(i == capacity) return;
+        
+        for(std::size_t j = (i + 1) & mask(); owned[j].slot != emptySlot; j = (j + 1) & mask()) {
+            std::size_t home = owned[j].hash & mask();
+            // Move j back into the hole at i unless its home lies in (i, j]
+            bool homeBetween = (i <= j) ? (home > i && home <= j) : (home > i || home <= j);
+            if(!homeBetween) {
+                owned[i] = owned[j];
+                i = j;
+            }
+        }
+        owned[i] = IdIndexBucket{0, emptySlot};
+        --used;
+    }
+    
+    void relocate(std::string_view id, std::size_t from, std::size_t to) {
+        std::size_t i = findBucket(hashId(id), static_cast<std::uint32_t>(from));
+        if(i != capacity) owned[i].slot = static_cast<std::uint32_t>(to);
+    }
+    
+    // First slot registered under id, or npos
+    std::size_t find(std::string_view id, const FleetColumns& c) const {
+        if(capacity == 0) return npos;
+        std::uint32_t h = hashId(id);
+        for(std::size_t i = h & mask(); table[i].slot != emptySlot; i = (i + 1) & mask()) {
+            if(table[i].hash == h && c.getId(table[i].slot) == id) {
+                return table[i].slot;
+            }
+        }
+        return npos;
+    }
+    
+    const IdIndexBucket* buckets() const { return table; }
+    std::size_t bucketCount() const { return capacity; }
+    std::size_t entries() const { return used; }
+    
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+};
+
+// Memory-mapped fleet snapshot (native layout, version checked). The file is
+// a 64-byte aligned header followed by 64-byte aligned columns: the fleet
+// columns, precomputed 1/lambda and k/lambda, and the packed ID pool. The
+// header also carries the running fleet aggregates and the ID hash index,
+// so O(1) queries and ID lookups need no scan or rebuild after opening.
+constexpr char fleetSnapshotMagic[8] = {'I', 'O', 'T', 'S', 'N', 'A', 'P', '\0'};
+constexpr std::uint32_t fleetSnapshotVersion = 3;
+constexpr std::uint32_t fleetSnapshotByteOrder = 0x01020304;
+
+enum SnapshotColumn {
+    SNAP_HEALTH, SNAP_RATE, SNAP_K, SNAP_UPTIME, SNAP_TYPE,
+    SNAP_LOC_X, SNAP_LOC_Y, SNAP_LOC_Z, SNAP_QUEUE,
+    SNAP_MTBF, SNAP_MTTF, SNAP_ID_START, SNAP_ID_LENGTH, SNAP_ID_POOL, SNAP_ID_INDEX,
+    SNAP_COLUMN_COUNT
+};
+
+// One type partition's slot range and running aggregates
+struct SnapshotTypePartition {
+    std::uint64_t begin;
+    std::uint64_t end;
+    double mtbfSum;
+    double mttfSum;
+    std::int64_t active;
+    std::int64_t warning;
+    std::int64_t failed;
+    std::int64_t cascadeFailures;
+    std::uint64_t stageCount[maxSpecializedStages + 1];
+};
+
+struct alignas(64) FleetSnapshotHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint64_t count;
+    std::uint64_t idPoolBytes;
+    std::uint64_t idIndexBuckets;
+    double mtbfSum;
+    double mttfSum;
+    std::int64_t active;
+    std::int64_t warning;
+    std::int64_t failed;
+    std::int64_t cascadeFailures;
+    SnapshotTypePartition partitions[sensorTypeCount];
+    std::uint64_t columnOffset[SNAP_COLUMN_COUNT];
+};
+
+class MappedFleetSnapshot {
+private:
+    const char* base = nullptr;
+    std::size_t length = 0;
+    FleetColumns view;
+    const FleetSnapshotHeader* header = nullptr;
+    const IdIndexBucket* index = nullptr;
+    
+    MappedFleetSnapshot() = default;
+
+public:
+    std::size_t mappedBytes() const { return length; }
+
+    ~MappedFleetSnapshot() {
+#ifdef RELIABILITY_HAVE_MMAP
+        if(base) munmap(const_cast<char*>(base), length);
+#endif
+    }
+    
+    MappedFleetSnapshot(const MappedFleetSnapshot&) = delete;
+    MappedFleetSnapshot& operator=(const MappedFleetSnapshot&) = delete;
+    
+    // Map a snapshot read-only; returns nullptr if the file is missing,
+    // truncated, structurally corrupt or written by an incompatible build.
+    // Besides the header and column extents, opening checks every ID extent
+    // and index bucket, and that each sensor's type matches its partition
+    // and its stage count is at least 1 (the columns used as indices once
+    // the fleet is materialized), about 13 bytes read per sensor. The other
+    // data columns are not read.
+    static std::shared_ptr<const MappedFleetSnapshot> open(const std::string& path) {
+#ifdef RELIABILITY_HAVE_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0) return nullptr;
+        
+        struct stat st;
+        if(fstat(fd, &st) != 0 || 
+           static_cast<std::size_t>(st.st_size) < sizeof(FleetSnapshotHeader)) {
+            ::close(fd);
+            return nullptr;
+        }
+        
+        std::size_t length = static_cast<std::size_t>(st.st_size);
+        void* addr = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if(addr == MAP_FAILED) return nullptr;
+        
+        std::shared_ptr<MappedFleetSnapshot> snap(new MappedFleetSnapshot());
+        snap->base = static_cast<const char*>(addr);
+        snap->length = length;
+        snap->header = reinterpret_cast<const FleetSnapshotHeader*>(snap->base);
+        
+        const FleetSnapshotHeader& h = *snap->header;
+        if(std::memcmp(h.magic, fleetSnapshotMagic, sizeof(h.magic)) != 0 ||
+           h.version != fleetSnapshotVersion || h.byteOrder != fleetSnapshotByteOrder) {
+            return nullptr;
+        }
+        
+        const std::size_t n = h.count;
+        const std::size_t widths[SNAP_COLUMN_COUNT] = {
+            sizeof(double), sizeof(double), sizeof(int), sizeof(double), sizeof(SensorType),
+            sizeof(double), sizeof(double), sizeof(double), sizeof(int),
+            sizeof(double), sizeof(double), sizeof(std::uint32_t), sizeof(std::uint32_t), 0, 0
+        };
+        // Sizes are bounded by the file length before they are multiplied
+        if(h.idIndexBuckets > length / sizeof(IdIndexBucket)) return nullptr;
+        for(int c = 0; c < SNAP_COLUMN_COUNT; ++c) {
+            if(widths[c] != 0 && n > length / widths[c]) return nullptr;
+            std::size_t bytes = (c == SNAP_ID_POOL) ? h.idPoolBytes 
+                              : (c == SNAP_ID_INDEX) ? h.idIndexBuckets * sizeof(IdIndexBucket)
+                              : n * widths[c];
+            if(h.columnOffset[c] % 64 != 0 || h.columnOffset[c] > length ||
+               bytes > length - h.columnOffset[c]) {
+                return nullptr;
+            }
+        }
+        
+        for(std::size_t t = 0; t < sensorTypeCount; ++t) {
+            const SnapshotTypePartition& p = h.partitions[t];
+            std::uint64_t expectedBegin = t ? h.partitions[t - 1].end : 0;
+            if(p.begin != expectedBegin || p.end < p.begin || p.end > n) return nullptr;
+        }
+        if(h.partitions[sensorTypeCount - 1].end != n) return nullptr;
+        
+        auto column = [&](int c) { return snap->base + h.columnOffset[c]; };
+        
+        // getId and the index probe loop trust these, so check them here
+        const auto* idStart = reinterpret_cast<const std::uint32_t*>(column(SNAP_ID_START));
+        const auto* idLength = reinterpret_cast<const std::uint32_t*>(column(SNAP_ID_LENGTH));
+        for(std::size_t i = 0; i < n; ++i) {
+            if(idLength[i] > h.idPoolBytes || idStart[i] > h.idPoolBytes - idLength[i]) {
+                return nullptr;
+            }
+        }
+        if(!SensorIdIndex::isValidTable(reinterpret_cast<const IdIndexBucket*>(column(SNAP_ID_INDEX)),
+                                        h.idIndexBuckets, n)) {
+            return nullptr;
+        }
+        const auto* types = reinterpret_cast<const SensorType*>(column(SNAP_TYPE));
+        const auto* kStages = reinterpret_cast<const int*>(column(SNAP_K));
+        for(std::size_t t = 0; t < sensorTypeCount; ++t) {
+            for(std::size_t i = h.partitions[t].begin; i < h.partitions[t].end; ++i) {
+                if(types[i] != static_cast<SensorType>(t) || kStages[i] < 1) return nullptr;
+            }
+        }
+        FleetColumns& v = snap->view;
+        v.count = n;
+        for(std::size_t t = 0; t < sensorTypeCount; ++t) {
+            v.typeBegin[t] = h.partitions[t].begin;
+        }
+        v.typeBegin[sensorTypeCount] = n;
+        v.health = reinterpret_cast<const double*>(column(SNAP_HEALTH));
+        v.failureRate = reinterpret_cast<const double*>(column(SNAP_RATE));
+        v.kStages = kStages;
+        v.uptimeHours = reinterpret_cast<const double*>(column(SNAP_UPTIME));
+        v.types = types;
+        v.locX = reinterpret_cast<const double*>(column(SNAP_LOC_X));
+        v.locY = reinterpret_cast<const double*>(column(SNAP_LOC_Y));
+        v.locZ = reinterpret_cast<const double*>(column(SNAP_LOC_Z));
+        v.queuePositions = reinterpret_cast<const int*>(column(SNAP_QUEUE));
+        v.mtbf = reinterpret_cast<const double*>(column(SNAP_MTBF));
+        v.mttf = reinterpret_cast<const double*>(column(SNAP_MTTF));
+        v.idStart = idStart;
+        v.idLength = idLength;
+        v.idPool = column(SNAP_ID_POOL);
+        snap->index = reinterpret_cast<const IdIndexBucket*>(column(SNAP_ID_INDEX));
+        return snap;
+#else
+        (void)path;
+        return nullptr;
+#endif
+    }
+    
+    const FleetColumns& columns() const { return view; }
+    const FleetSnapshotHeader& getHeader() const { return *header; }
+    const IdIndexBucket* idIndex() const { return index; }
+};
+
+// Neumaier-compensated running sum; supports removal by adding -x
+class CompensatedSum {
+private:
+    double sum = 0.0;
+    double compensation = 0.0;
+
+public:
+    void add(double x) {
+        double t = sum + x;
+        if(std::abs(sum) >= std::abs(x)) {
+            compensation += (sum - t) + x;
+        } else {
+            compensation += (x - t) + sum;
+        }
+        sum = t;
+    }
+    
+    void subtract(double x) {
+        add(-x);
+    }
+    
+    double value() const {
+        return sum + compensation;
+    }
+    
+    void reset() {
+        sum = 0.0;
+        compensation = 0.0;
+    }
+};
+
+// Health-bucket and cascade counts, adjustable one sensor at a time
+struct HealthTally {
+    int active = 0;
+    int warning = 0;
+    int failed = 0;
+    int cascadeFailures = 0;
+    
+    // Count (sign = +1) or uncount (sign = -1) one health value
+    void add(double health, int sign) {
+        if(health > 70.0) {
+            active += sign;
+        } else if(health > 30.0) {
+            warning += sign;
+        } else {
+            failed += sign;
+        }
+        if(health < 30.0) {
+            cascadeFailures += sign;
+        }
+    }
+};
+
+// Immutable health column published by a ConcurrentHealthBoard refresh
+struct HealthSnapshot {
+    std::uint64_t epoch;
+    AlignedVector<double> health;
+    HealthTally tally;
+};
+
+// Lock-free health-update path for live telemetry. Writers store into a
+// per-slot atomic and mark the slot in a dirty bitmap; neither step takes a
+// lock. acquire() folds dirty slots into a new immutable HealthSnapshot with
+// the next epoch number. A snapshot contains every update published before its
+// refresh began, and never changes while readers hold it.
+// Snapshots are recycled. When the last reader drops a snapshot, its buffer
+// returns to a small pool, and the board logs the slots changed at each
+// recent epoch. A refresh takes the newest pooled buffer, brings it up to
+// date by copying only the slots changed since its epoch, then folds in the
+// new updates, so it costs O(changed slots) beyond the scan of the dirty
+// bitmap (one word per 64 slots) rather than an O(N) copy. Only when no
+// buffer is free (readers still pin every old snapshot), or the free one
+// predates the change log, does a refresh copy the whole column.
+class ConcurrentHealthBoard {
+private:
+    static_assert(std::atomic<double>::is_always_lock_free, "atomic<double> must be lock-free");
+    static constexpr std::size_t retainedSnapshots = 2;
+    
+    // Outlives the board while readers still hold snapshots
+    struct SnapshotPool {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<HealthSnapshot>> free;
+    };
+    
+    std::size_t count;
+    std::size_t words;
+    std::unique_ptr<std::atomic<double>[]> latest;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> dirty;
+    
+    // Serializes refreshing readers only; writers never touch it
+    std::mutex refreshMutex;
+    std::shared_ptr<const HealthSnapshot> current;
+    std::shared_ptr<SnapshotPool> pool = std::make_shared<SnapshotPool>();
+    std::vector<std::uint32_t> changes[retainedSnapshots];   // by epoch % retained
+    std::vector<std::uint32_t> pending;
+    
+    // Hand out a snapshot whose buffer returns to the pool when released.
+    // free has its full capacity reserved, so the deleter never allocates.
+    std::shared_ptr<const HealthSnapshot> lease(std::unique_ptr<HealthSnapshot> snapshot) {
+        std::shared_ptr<SnapshotPool> home = pool;
+        return std::shared_ptr<const HealthSnapshot>(snapshot.release(), [home](const HealthSnapshot* s) {
+            std::unique_ptr<HealthSnapshot> owned(const_cast<HealthSnapshot*>(s));
+            std::lock_guard<std::mutex> lock(home->mutex);
+            if(home->free.size() < retainedSnapshots) home->free.push_back(std::move(owned));
+        });
+    }
+    
+    // A copy of current, built from the newest pooled buffer when one is free
+    std::unique_ptr<HealthSnapshot> copyCurrent() {
+        std::unique_ptr<HealthSnapshot> snapshot;
+        {
+            std::lock_guard<std::mutex> lock(pool->mutex);
+            auto newest = std::max_element(pool->free.begin(), pool->free.end(),
+                [](const auto& a, const auto& b) { return a->epoch < b->epoch; });
+            if(newest != pool->free.end()) {
+                snapshot = std::move(*newest);
+                pool->free.erase(newest);
+            }
+        }
+        if(!snapshot) return std::make_unique<HealthSnapshot>(*current);
+        
+        if(snapshot->epoch + retainedSnapshots < current->epoch) {
+            std::copy(current->health.begin(), current->health.end(), snapshot->health.begin());
+        } else {
+            for(std::uint64_t e = snapshot->epoch + 1; e <= current->epoch; ++e) {
+                for(std::uint32_t slot : changes[e % retainedSnapshots]) {
+                    snapshot->health[slot] = current->health[slot];
+                }
+            }
+        }
+        snapshot->tally = current->tally;
+        return snapshot;
+    }
+
+public:
+    ConcurrentHealthBoard(const double* health, std::size_t n, const HealthTally& tally)
+        : count(n), words((n + 63) / 64),
+          latest(new std::atomic<double>[n]), 
+          dirty(new std::atomic<std::uint64_t>[words]) {
+        for(std::size_t i = 0; i < n; ++i) {
+            latest[i].store(health[i], std::memory_order_relaxed);
+        }
+        for(std::size_t w = 0; w < words; ++w) {
+            dirty[w].store(0, std::memory_order_relaxed);
+        }
+        
+        pool->free.reserve(retainedSnapshots);
+        auto initial = std::make_unique<HealthSnapshot>();
+        initial->epoch = 0;
+        initial->health.assign(health, health + n);
+        initial->tally = tally;
+        current = lease(std::move(initial));
+    }
+    
+    std::size_t size() const { return count; }
+    
+    // Safe from any number of threads concurrently; false if slot is out
+    // of range
+    bool publish(std::size_t slot, double health) noexcept {
+        if(slot >= count) return false;
+        latest[slot].store(health, std::memory_order_relaxed);
+        dirty[slot / 64].fetch_or(std::uint64_t(1) << (slot % 64), std::memory_order_release);
+        return true;
+    }
+    
+    // Current snapshot, refreshed first if any update is pending
+    std::shared_ptr<const HealthSnapshot> acquire() {
+        std::lock_guard<std::mutex> lock(refreshMutex);
+        
+        pending.clear();
+        for(std::size_t w = 0; w < words; ++w) {
+            if(dirty[w].load(std::memory_order_relaxed) == 0) continue;
+            std::uint64_t bits = dirty[w].exchange(0, std::memory_order_acquire);
+            while(bits) {
+                pending.push_back(static_cast<std::uint32_t>(w * 64 + __builtin_ctzll(bits)));
+                bits &= bits - 1;
+            }
+        }
+        if(pending.empty()) return current;
+        
+        std::unique_ptr<HealthSnapshot> next = copyCurrent();
+        next->epoch = current->epoch + 1;
+        for(std::uint32_t slot : pending) {
+            double value = latest[slot].load(std::memory_order_relaxed);
+            next->tally.add(next->health[slot], -1);
+            next->tally.add(value, +1);
+            next->health[slot] = value;
+        }
+        
+        changes[next->epoch % retainedSnapshots].swap(pending);
+        current = lease(std::move(next));
+        return current;
+    }
+};
+
+// Append-only health history of one sensor in Gorilla-style compressed
+// blocks. Timestamps (seconds) are delta-of-delta coded and values XOR-coded
+// against the previous sample. Each block restarts both codings, so it
+// decodes on its own, and records its time span and exact health min/max so
+// window queries skip whole blocks without decoding them. Steady one-minute
+// telemetry costs about 2 bits per sample; full-precision noisy values cost
+// ~6.7 bytes, which a reduced history precision brings near 0.3-0.5 bytes.
+constexpr std::size_t historyBlockSamples = 1024;
+
+struct HealthSample {
+    std::int64_t time;
+    double health;
+};
+
+class HealthSeries {
+public:
+    struct Block {
+        std::int64_t firstTime;
+        std::int64_t lastTime;
+        double minHealth;
+        double maxHealth;
+        std::uint64_t bitOffset;
+        std::uint32_t count;
+    };
+
+private:
+    std::vector<std::uint64_t> words;
+    std::vector<Block> blocks;
+    std::uint64_t bitCount = 0;
+    
+    // Coder state at the end of the open (last) block
+    std::int64_t lastDelta = 0;
+    std::uint64_t lastBits = 0;
+    int leading = -1;    // -1: no XOR window yet in this block
+    int trailing = 0;
+    
+    // Append the low n bits of value, most significant first (1 <= n <= 64).
+    // Words grow by an eighth at a time to bound the slack over a month.
+    void writeBits(std::uint64_t value, int n) {
+        const int used = static_cast<int>(bitCount & 63);
+        if(used == 0) pushWord();
+        const int space = 64 - used;
+        if(n <= space) {
+            words.back() |= value << (space - n);
+        } else {
+            words.back() |= value >> (n - space);
+            pushWord();
+            words.back() |= value << (64 - (n - space));
+        }
+        bitCount += static_cast<std::uint64_t>(n);
+    }
+    
+    void pushWord() {
+        if(words.size() == words.capacity()) {
+            words.reserve(words.size() + words.size() / 8 + 8);
+        }
+        words.push_back(0);
+    }
+    
+    struct BitReader {
+        const std::uint64_t* words;
+        std::uint64_t pos;
+        
+        std::uint64_t read(int n) {
+            const std::size_t w = static_cast<std::size_t>(pos >> 6);
+            const int offset = static_cast<int>(pos & 63);
+            const std::uint64_t head = words[w] << offset;
+            std::uint64_t value = head >> (64 - n);
+            if(offset + n > 64) {
+                value |= words[w + 1] >> (128 - offset - n);
+            }
+            pos += static_cast<std::uint64_t>(n);
+            return value;
+        }
+        
+        bool bit() { return read(1) != 0; }
+    };
+    
+    static std::uint64_t bitsOf(double x) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &x, sizeof bits);
+        return bits;
+    }
+    
+    static double valueOf(std::uint64_t bits) {
+        double x;
+        std::memcpy(&x, &bits, sizeof x);
+        return x;
+    }
+
+public:
+    std::size_t size() const {
+        return blocks.empty() ? 0 
+            : (blocks.size() - 1) * historyBlockSamples + blocks.back().count;
+    }
+    
+    const std::vector<Block>& blockList() const { return blocks; }
+    
+    std::size_t memoryBytes() const {
+        return words.capacity() * sizeof(std::uint64_t) + blocks.capacity() * sizeof(Block);
+    }
+    
+    // Returns false (and stores nothing) if time precedes the latest sample
+    bool append(std::int64_t time, double health) {
+        if(!blocks.empty() && time < blocks.back().lastTime) return false;
+        const std::uint64_t bits = bitsOf(health);
+        
+        if(blocks.empty() || blocks.back().count == historyBlockSamples) {
+            blocks.push_back({time, time, health, health, bitCount, 1});
+            writeBits(static_cast<std::uint64_t>(time), 64);
+            writeBits(bits, 64);
+            lastDelta = 0;
+            lastBits = bits;
+            leading = -1;
+            return true;
+        }
+        
+        Block& block = blocks.back();
+        const std::int64_t delta = time - block.lastTime;
+        const std::int64_t dod = delta - lastDelta;
+        if(dod == 0) {
+            writeBits(0, 1);
+        } else if(dod >= -63 && dod <= 64) {
+            writeBits((std::uint64_t(0x2) << 7) | static_cast<std::uint64_t>(dod + 63), 9);
+        } else if(dod >= -255 && dod <= 256) {
+            writeBits((std::uint64_t(0x6) << 9) | static_cast<std::uint64_t>(dod + 255), 12);
+        } else if(dod >= -2047 && dod <= 2048) {
+            writeBits((std::uint64_t(0xE) << 12) | static_cast<std::uint64_t>(dod + 2047), 16);
+        } else {
+            writeBits(0xF, 4);
+            writeBits(static_cast<std::uint64_t>(dod), 64);
+        }
+        
+        const std::uint64_t x = bits ^ lastBits;
+        if(x == 0) {
+            writeBits(0, 1);
+        } else {
+            const int lz = std::min(__builtin_clzll(x), 31);
+            const int tz = __builtin_ctzll(x);
+            if(leading >= 0 && lz >= leading && tz >= trailing) {
+                writeBits(0x2, 2);
+                writeBits(x >> trailing, 64 - leading - trailing);
+            } else {
+                const int length = 64 - lz - tz;
+                writeBits(0x3, 2);
+                writeBits(static_cast<std::uint64_t>(lz), 5);
+                writeBits(static_cast<std::uint64_t>(length - 1), 6);
+                writeBits(x >> tz, length);
+                leading = lz;
+                trailing = tz;
+            }
+        }
+        
+        lastDelta = delta;
+        lastBits = bits;
+        block.lastTime = time;
+        block.minHealth = std::min(block.minHealth, health);
+        block.maxHealth = std::max(block.maxHealth, health);
+        block.count++;
+        return true;
+    }
+    
+    // Decode block b in time order, calling fn(time, health) until it
+    // returns false; returns false if stopped early
+    template<typename Fn>
+    bool scanBlock(std::size_t b, Fn&& fn) const {
+        const Block& block = blocks[b];
+        BitReader in{words.data(), block.bitOffset};
+        std::int64_t time = static_cast<std::int64_t>(in.read(64));
+        std::uint64_t bits = in.read(64);
+        if(!fn(time, valueOf(bits))) return false;
+        
+        std::int64_t delta = 0;
+        int lead = 0, trail = 0;
+        for(std::uint32_t i = 1; i < block.count; ++i) {
+            std::int64_t dod = 0;
+            if(in.bit()) {
+                if(!in.bit()) {
+                    dod = static_cast<std::int64_t>(in.read(7)) - 63;
+                } else if(!in.bit()) {
+                    dod = static_cast<std::int64_t>(in.read(9)) - 255;
+                } else if(!in.bit()) {
+                    dod = static_cast<std::int64_t>(in.read(12)) - 2047;
+                } else {
+                    dod = static_cast<std::int64_t>(in.read(64));
+                }
+            }
+            delta += dod;
+            time += delta;
+            
+            if(in.bit()) {
+                if(in.bit()) {
+                    lead = static_cast<int>(in.read(5));
+                    const int length = static_cast<int>(in.read(6)) + 1;
+                    trail = 64 - lead - length;
+                }
+                bits ^= in.read(64 - lead - trail) << trail;
+            }
+            if(!fn(time, valueOf(bits))) return false;
+        }
+        return true;
+    }
+    
+    // Samples with time in [from, to], appended to out in time order
+    void read(std::int64_t from, std::int64_t to, std::vector<HealthSample>& out) const {
+        for(std::size_t b = 0; b < blocks.size(); ++b) {
+            if(blocks[b].lastTime < from) continue;
+            if(blocks[b].firstTime > to) break;
+            scanBlock(b, [&](std::int64_t time, double health) {
+                if(time > to) return false;
+                if(time >= from) out.push_back({time, health});
+                return true;
+            });
+        }
+    }
+    
+    // Lowest health over [from, to] (+inf if no sample). Blocks wholly inside
+    // the window answer from their summary; only the edge blocks decode.
+    double minHealth(std::int64_t from, std::int64_t to) const {
+        double lowest = std::numeric_limits<double>::infinity();
+        for(std::size_t b = 0; b < blocks.size(); ++b) {
+            const Block& block = blocks[b];
+            if(block.lastTime < from) continue;
+            if(block.firstTime > to) break;
+            if(block.minHealth >= lowest) continue;
+            if(block.firstTime >= from && block.lastTime <= to) {
+                lowest = block.minHealth;
+                continue;
+            }
+            scanBlock(b, [&](std::int64_t time, double health) {
+                if(time > to) return false;
+                if(time >= from) lowest = std::min(lowest, health);
+                return true;
+            });
+        }
+        return lowest;
+    }
+    
+    // Whether any sample in [from, to] is below threshold; blocks outside the
+    // window or with minimum at or above it are skipped undecoded
+    bool droppedBelow(double threshold, std::int64_t from, std::int64_t to) const {
+        for(std::size_t b = 0; b < blocks.size(); ++b) {
+            const Block& block = blocks[b];
+            if(block.firstTime > to) break;
+            if(block.lastTime < from || block.minHealth >= threshold) continue;
+            if(block.firstTime >= from && block.lastTime <= to) return true;
+            bool found = false;
+            scanBlock(b, [&](std::int64_t time, double health) {
+                if(time > to) return false;
+                found = time >= from && health < threshold;
+                return !found;
+            });
+            if(found) return true;
+        }
+        return false;
+    }
+};
+
+// Slot-indexed health histories, moved along with their sensors. Values
+// are rounded to mantissaBits significant bits (52 keeps them exact), so
+// the XOR of nearby values ends in zeros; 12 bits resolves 0.025 near 100.
+class HealthHistory {
+private:
+    std::vector<HealthSeries> series;
+    std::uint64_t dropMask;
+
+public:
+    explicit HealthHistory(std::size_t n, int mantissaBits = 52)
+        : series(n), 
+          dropMask((std::uint64_t(1) << (52 - std::clamp(mantissaBits, 1, 52))) - 1) {}
+    
+    // Round to nearest on the kept mantissa bits; non-finite values pass
+    double quantize(double health) const {
+        if(dropMask == 0 || !std::isfinite(health)) return health;
+        std::uint64_t bits;
+        std::memcpy(&bits, &health, sizeof bits);
+        bits = (bits + (dropMask >> 1) + 1) & ~dropMask;
+        std::memcpy(&health, &bits, sizeof bits);
+        return health;
+    }
+    
+    std::size_t size() const { return series.size(); }
+    void resize(std::size_t n) { series.resize(n); }
+    
+    void relocate(std::size_t from, std::size_t to) {
+        series[to] = std::move(series[from]);
+        series[from] = HealthSeries();
+    }
+    
+    bool append(std::size_t slot, std::int64_t time, double health) {
+        return series[slot].append(time, quantize(health));
+    }
+    
+    const HealthSeries& operator[](std::size_t slot) const { return series[slot]; }
+    
+    std::size_t samples() const {
+        std::size_t total = 0;
+        for(const auto& s : series) total += s.size();
+        return total;
+    }
+    
+    std::size_t memoryBytes() const {
+        std::size_t total = series.capacity() * sizeof(HealthSeries);
+        for(const auto& s : series) total += s.memoryBytes();
+        return total;
+    }
+};
+
+// Query region over sensor (x, y) locations: an axis-aligned district box
+// or a radius around a point
+struct Region {
+    double minX, minY, maxX, maxY;
+    bool circular;
+    double centerX, centerY, radius;
+    
+    static Region box(double x0, double y0, double x1, double y1) {
+        return {std::min(x0, x1), std::min(y0, y1), std::max(x0, x1), std::max(y0, y1),
+                false, 0.0, 0.0, 0.0};
+    }
+    
+    static Region circle(double cx, double cy, double r) {
+        return {cx - r, cy - r, cx + r, cy + r, true, cx, cy, r};
+    }
+    
+    bool contains(double x, double y) const {
+        if(x < minX || x > maxX || y < minY || y > maxY) return false;
+        if(!circular) return true;
+        double dx = x - centerX, dy = y - centerY;
+        return dx * dx + dy * dy <= radius * radius;
+    }
+};
+
+// Uniform hashed grid over sensor (x, y). Each slot records its cell and
+// position within the cell, so insert, erase and relocate are all O(1).
+class SpatialGrid {
+private:
+    double cellSize;
+    std::vector<std::vector<std::uint32_t>> cells;
+    std::unordered_map<std::uint64_t, std::uint32_t> cellIds;
+    std::vector<std::uint32_t> slotCell;
+    std::vector<std::uint32_t> slotPos;
+    
+    std::int64_t cellCoord(double v) const {
+        return static_cast<std::int64_t>(std::floor(v / cellSize));
+    }
+    
+    static std::uint64_t cellKey(std::int64_t cx, std::int64_t cy) {
+        return (static_cast<std::uint64_t>(cx) << 32) ^ 
+               (static_cast<std::uint64_t>(cy) & 0xFFFFFFFFu);
+    }
+    
+    std::uint32_t cellFor(double x, double y) {
+        std::uint64_t key = cellKey(cellCoord(x), cellCoord(y));
+        auto it = cellIds.find(key);
+        if(it != cellIds.end()) return it->second;
+        std::uint32_t id = static_cast<std::uint32_t>(cells.size());
+        cells.emplace_back();
+        cellIds.emplace(key, id);
+        return id;
+    }
+
+public:
+    explicit SpatialGrid(double cell = 5.0) : cellSize(cell) {}
+    
+    void clear() {
+        cells.clear();
+        cellIds.clear();
+        slotCell.clear();
+        slotPos.clear();
+    }
+    
+    void build(const FleetColumns& c) {
+        clear();
+        for(std::size_t i = 0; i < c.count; ++i) {
+            insert(i, c.locX[i], c.locY[i]);
+        }
+    }
+    
+    void insert(std::size_t slot, double x, double y) {
+        std::uint32_t cell = cellFor(x, y);
+        if(slotCell.size() <= slot) {
+            slotCell.resize(slot + 1);
+            slotPos.resize(slot + 1);
+        }
+        slotCell[slot] = cell;
+        slotPos[slot] = static_cast<std::uint32_t>(cells[cell].size());
+        cells[cell].push_back(static_cast<std::uint32_t>(slot));
+    }
+    
+    void erase(std::size_t slot) {
+        auto& members = cells[slotCell[slot]];
+        std::uint32_t pos = slotPos[slot];
+        std::uint32_t moved = members.back();
+        members[pos] = moved;
+        slotPos[moved] = pos;
+        members.pop_back();
+    }
+    
+    // The sensor in slot from now lives in slot to, whose previous
+    // occupant has been erased or relocated already
+    void relocate(std::size_t from, std::size_t to) {
+        if(slotCell.size() <= to) {
+            slotCell.resize(to + 1);
+            slotPos.resize(to + 1);
+        }
+        cells[slotCell[from]][slotPos[from]] = static_cast<std::uint32_t>(to);
+        slotCell[to] = slotCell[from];
+        slotPos[to] = slotPos[from];
+    }
+    
+    void truncate(std::size_t size) {
+        slotCell.resize(size);
+        slotPos.resize(size);
+    }
+    
+    // Visit every slot whose location lies in the region
+    template<typename Fn>
+    void forEach(const Region& region, const FleetColumns& c, Fn&& fn) const {
+        std::int64_t x0 = cellCoord(region.minX), x1 = cellCoord(region.maxX);
+        std::int64_t y0 = cellCoord(region.minY), y1 = cellCoord(region.maxY);
+        
+        // Very large regions: walking the occupied cells beats the box
+        bool walkAll = static_cast<double>(x1 - x0 + 1) * (y1 - y0 + 1) > 
+                       static_cast<double>(cells.size());
+        auto visitCell = [&](const std::vector<std::uint32_t>& members) {
+            for(std::uint32_t slot : members) {
+                if(region.contains(c.locX[slot], c.locY[slot])) fn(slot);
+            }
+        };
+        
+        if(walkAll) {
+            for(const auto& members : cells) visitCell(members);
+            return;
+        }
+        for(std::int64_t cx = x0; cx <= x1; ++cx) {
+            for(std::int64_t cy = y0; cy <= y1; ++cy) {
+                auto it = cellIds.find(cellKey(cx, cy));
+                if(it != cellIds.end()) visitCell(cells[it->second]);
+            }
+        }
+    }
+};
+
+// Work-stealing thread pool: one deque per worker, owners pop from the back,
+// idle workers steal from the front of their neighbours' deques
+// Restrict the calling thread to the given CPUs; false where thread
+// affinity is unsupported or the set is rejected
+inline bool pinCurrentThread(const std::vector<int>& cpus) {
+#ifdef RELIABILITY_HAVE_AFFINITY
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for(int cpu : cpus) {
+        if(cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+class ThreadPool {
+private:
+    using Task = std::function<void()>;
+    
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+    
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<std::size_t> pending{0};
+    std::atomic<std::size_t> nextQueue{0};
+    std::vector<int> cpus;              // worker affinity; empty leaves it to the OS
+    bool stopping = false;
+    
+    static std::size_t& workerIndex() {
+        static thread_local std::size_t index = static_cast<std::size_t>(-1);
+        return index;
+    }
+    
+    bool popTask(std::size_t self, Task& task) {
+        const std::size_t n = queues.size();
+        
+        if(self < n) {
+            WorkQueue& own = *queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if(!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+        
+        std::size_t start = (self < n) ? self + 1 : 0;
+        for(std::size_t i = 0; i < n; ++i) {
+            WorkQueue& victim = *queues[(start + i) % n];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if(!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        
+        return false;
+    }
+    
+    bool runOne(std::size_t self) {
+        Task task;
+        if(!popTask(self, task)) return false;
+        pending.fetch_sub(1, std::memory_order_relaxed);
+        task();
+        return true;
+    }
+    
+    void workerLoop(std::size_t self) {
+        workerIndex() = self;
+        if(!cpus.empty()) pinCurrentThread(cpus);
+        for(;;) {
+            if(runOne(self)) continue;
+            
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wake.wait(lock, [this] {
+                return stopping || pending.load(std::memory_order_relaxed) > 0;
+            });
+            if(stopping && pending.load(std::memory_order_relaxed) == 0) return;
+        }
+    }
+
+public:
+    explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency())
+        : ThreadPool(threads, {}) {}
+    
+    // Workers restricted to the given CPUs (a NUMA node's, for example)
+    ThreadPool(std::size_t threads, std::vector<int> cpuSet) : cpus(std::move(cpuSet)) {
+        threads = std::max<std::size_t>(threads, 1);
+        for(std::size_t i = 0; i < threads; ++i) {
+            queues.push_back(std::make_unique<WorkQueue>());
+        }
+        for(std::size_t i = 0; i < threads; ++i) {
+            workers.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+    
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for(auto& worker : workers) {
+            worker.join();
+        }
+    }
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    std::size_t size() const {
+        return workers.size();
+    }
+    
+    void submit(Task task) {
+        std::size_t self = workerIndex();
+        std::size_t target = (self < queues.size()) 
+            ? self 
+            : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+        {
+            std::lock_guard<std::mutex> lock(queues[target]->mutex);
+            queues[target]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            pending.fetch_add(1, std::memory_order_relaxed);
+        }
+        wake.notify_one();
+    }
+    
+    // Run body(i) for every i in [0, count) and wait; the calling thread
+    // helps by stealing, so nested calls from inside a task do not deadlock
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& body) {
+        if(count == 0) return;
+        
+        // Tasks capture two words so std::function stores them inline
+        // instead of allocating one closure per index
+        struct Batch {
+            const std::function<void(std::size_t)>* body;
+            std::atomic<std::size_t> remaining;
+        } batch{&body, {count}};
+        for(std::size_t i = 0; i < count; ++i) {
+            Batch* b = &batch;
+            submit([b, i] {
+                (*b->body)(i);
+                b->remaining.fetch_sub(1, std::memory_order_acq_rel);
+            });
+        }
+        
+        std::size_t self = workerIndex();
+        while(batch.remaining.load(std::memory_order_acquire) > 0) {
+            if(!runOne(self)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    
+    static ThreadPool& shared() {
+        static ThreadPool pool;
+        return pool;
+    }
+};
+
+// CPUs of each NUMA node, read from sysfs on Linux. Machines without NUMA
+// information report a single node holding every CPU.
+struct NumaTopology {
+    std::vector<std::vector<int>> nodeCpus;
+    
+    std::size_t nodes() const {
+        return nodeCpus.size();
+    }
+    
+    // Parse a sysfs list such as "0-3,8-11"
+    static std::vector<int> parseCpuList(const std::string& list) {
+        std::vector<int> cpus;
+        std::stringstream in(list);
+        std::string range;
+        while(std::getline(in, range, ',')) {
+            int first = 0, last = 0;
+            int fields = std::sscanf(range.c_str(), "%d-%d", &first, &last);
+            if(fields < 1) continue;
+            if(fields == 1) last = first;
+            for(int cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        }
+        return cpus;
+    }
+    
+    static NumaTopology detect() {
+        NumaTopology topology;
+        auto readList = [](const std::string& path) {
+            std::ifstream in(path);
+            std::string list;
+            std::getline(in, list);
+            return parseCpuList(list);
+        };
+        const std::string root = "/sys/devices/system/node/";
+        for(int node : readList(root + "online")) {
+            std::vector<int> cpus = readList(root + "node" + std::to_string(node) + "/cpulist");
+            if(!cpus.empty()) topology.nodeCpus.push_back(std::move(cpus));
+        }
+        if(topology.nodeCpus.empty()) {
+            const int n = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+            topology.nodeCpus.emplace_back();
+            for(int cpu = 0; cpu < n; ++cpu) {
+                topology.nodeCpus[0].push_back(cpu);
+            }
+        }
+        return topology;
+    }
+    
+    static const NumaTopology& system() {
+        static const NumaTopology topology = detect();
+        return topology;
+    }
+};
+
+// One ThreadPool per NUMA node, its workers pinned to that node's CPUs.
+// Work split into unit ranges is sharded contiguously: node j owns units
+// [span * j / nodes, span * (j + 1) / nodes), and each shard runs on its own
+// node, so data first touched by a node's workers is scanned there too.
+class NumaExecutor {
+private:
+    std::vector<std::unique_ptr<ThreadPool>> pools;
+
+public:
+    explicit NumaExecutor(const NumaTopology& topology = NumaTopology::system()) {
+        for(const auto& cpus : topology.nodeCpus) {
+            pools.push_back(std::make_unique<ThreadPool>(cpus.size(), cpus));
+        }
+        if(pools.empty()) {
+            pools.push_back(std::make_unique<ThreadPool>());
+        }
+    }
+    
+    std::size_t nodes() const {
+        return pools.size();
+    }
+    
+    ThreadPool& nodePool(std::size_t node) {
+        return *pools[node];
+    }
+    
+    // First unit of node's shard when span units are spread over the nodes
+    std::size_t shardBegin(std::size_t node, std::size_t span) const {
+        return span * node / pools.size();
+    }
+    
+    // Run body(i) for every i in [0, count) and wait, each i on the node
+    // owning it under a layout of span units (count when span is smaller).
+    // The calling thread helps with node 0's shard.
+    void parallelFor(std::size_t count, std::size_t span,
+                     const std::function<void(std::size_t)>& body) {
+        if(count == 0) return;
+        span = std::max(span, count);
+        
+        auto runShard = [&](std::size_t node) {
+            const std::size_t begin = std::min(count, shardBegin(node, span));
+            const std::size_t end = std::min(count, shardBegin(node + 1, span));
+            if(begin == end) return;
+            std::function<void(std::size_t)> shifted = [&body, begin](std::size_t i) {
+                body(begin + i);
+            };
+            pools[node]->parallelFor(end - begin, shifted);
+        };
+        
+        std::atomic<std::size_t> remaining{pools.size() - 1};
+        for(std::size_t node = 1; node < pools.size(); ++node) {
+            pools[node]->submit([&runShard, &remaining, node] {
+                runShard(node);
+                remaining.fetch_sub(1, std::memory_order_acq_rel);
+            });
+        }
+        runShard(0);
+        while(remaining.load(std::memory_order_acquire) > 0) {
+            std::this_thread::yield();
+        }
+    }
+    
+    static NumaExecutor& shared() {
+        static NumaExecutor executor;
+        return executor;
+    }
+};
+
+// Sensor dependency graph in CSR form, slot-indexed. An edge u -> v with
+// weight w means a failure of u brings down v with probability w. Both the
+// forward (for frontier expansion) and reverse (for pull updates) adjacency
+// are kept.
+class DependencyGraph {
+public:
+    struct Edge {
+        std::uint32_t from;
+        std::uint32_t to;
+        double weight;
+    };
+
+private:
+    std::size_t nodeCount = 0;
+    std::vector<std::uint64_t> outOffsets{0};
+    std::vector<std::uint32_t> outTargets;
+    std::vector<std::uint64_t> inOffsets{0};
+    std::vector<std::uint32_t> inSources;
+    std::vector<double> inWeights;
+
+public:
+    // Counting-sort build; edges touching nodes >= nodes are dropped
+    static DependencyGraph fromEdges(std::size_t nodes, const std::vector<Edge>& edges) {
+        return fromEdges(nodes, edges.data(), edges.size());
+    }
+    
+    static DependencyGraph fromEdges(std::size_t nodes, const Edge* edgeList, std::size_t edgeCount) {
+        const Edge* edgeEnd = edgeList + edgeCount;
+        DependencyGraph g;
+        g.nodeCount = nodes;
+        g.outOffsets.assign(nodes + 1, 0);
+        g.inOffsets.assign(nodes + 1, 0);
+        
+        std::size_t valid = 0;
+        for(const Edge* e = edgeList; e != edgeEnd; ++e) {
+            if(e->from >= nodes || e->to >= nodes) continue;
+            g.outOffsets[e->from + 1]++;
+            g.inOffsets[e->to + 1]++;
+            ++valid;
+        }
+        for(std::size_t i = 0; i < nodes; ++i) {
+            g.outOffsets[i + 1] += g.outOffsets[i];
+            g.inOffsets[i + 1] += g.inOffsets[i];
+        }
+        
+        g.outTargets.resize(valid);
+        g.inSources.resize(valid);
+        g.inWeights.resize(valid);
+        ArenaScope scratch;
+        ScratchVector<std::uint64_t> outFill(g.outOffsets.begin(), g.outOffsets.end() - 1);
+        ScratchVector<std::uint64_t> inFill(g.inOffsets.begin(), g.inOffsets.end() - 1);
+        for(const Edge* e = edgeList; e != edgeEnd; ++e) {
+            if(e->from >= nodes || e->to >= nodes) continue;
+            g.outTargets[outFill[e->from]++] = e->to;
+            std::uint64_t slot = inFill[e->to]++;
+            g.inSources[slot] = e->from;
+            g.inWeights[slot] = e->weight;
+        }
+        return g;
+    }
+    
+    std::size_t nodes() const { return nodeCount; }
+    std::size_t edges() const { return outTargets.size(); }
+    bool empty() const { return nodeCount == 0; }
+    
+    std::uint64_t outBegin(std::size_t u) const { return outOffsets[u]; }
+    std::uint64_t outEnd(std::size_t u) const { return outOffsets[u + 1]; }
+    std::uint32_t outTarget(std::uint64_t e) const { return outTargets[e]; }
+    
+    std::uint64_t inBegin(std::size_t v) const { return inOffsets[v]; }
+    std::uint64_t inEnd(std::size_t v) const { return inOffsets[v + 1]; }
+    std::uint32_t inSource(std::uint64_t e) const { return inSources[e]; }
+    double inWeight(std::uint64_t e) const { return inWeights[e]; }
+};
+
+struct CascadePropagation {
+    std::vector<double> failureProbability;  // per slot, 1.0 for seeds
+    std::size_t seeds;
+    double expectedAdditional;               // sum over non-seed slots
+    int levels;
+};
+
+// Level-synchronous independent-cascade propagation from the failed seeds.
+// q_v accumulates 1 - (1 - q_v) * prod(1 - w_uv * a_u) over parents u that
+// newly failed (with probability mass a_u) in the previous level. Each level
+// expands the frontier's out-edges into candidates, then pulls each
+// candidate's in-edges; both phases run chunked on the pool. Every value is
+// computed by exactly one task from the previous level's data, so results do
+// not depend on scheduling. Nodes and edge endpoints at or beyond n are
+// ignored.
+inline CascadePropagation propagateFailures(const DependencyGraph& graph, const double* health,
+                                            std::size_t n, ThreadPool* pool,
+                                            int maxDepth, double epsilon) {
+    constexpr std::size_t chunk = 4096;
+    constexpr std::uint32_t never = 0xFFFFFFFFu;
+    
+    CascadePropagation result;
+    result.failureProbability.assign(n, 0.0);
+    result.seeds = 0;
+    result.expectedAdditional = 0.0;
+    result.levels = 0;
+    
+    // Per-node state and the level buffers come from the scratch arena
+    ArenaScope scratch;
+    MonotonicArena& arena = scratch.get();
+    std::vector<double>& prob = result.failureProbability;
+    double* delta = arena.allocateArray<double>(n);
+    std::uint32_t* level = arena.allocateArray<std::uint32_t>(n);
+    std::atomic<std::uint32_t>* mark = arena.allocateArray<std::atomic<std::uint32_t>>(n);
+    std::uint32_t* frontier = arena.allocateArray<std::uint32_t>(n);
+    std::uint32_t* candidates = arena.allocateArray<std::uint32_t>(n);
+    double* nextProb = arena.allocateArray<double>(n);
+    double* nextDelta = arena.allocateArray<double>(n);
+    std::size_t frontierSize = 0;
+    
+    for(std::size_t i = 0; i < n; ++i) {
+        new (&mark[i]) std::atomic<std::uint32_t>(never);
+        delta[i] = 0.0;
+        level[i] = never;
+        if(health[i] < 30.0) {
+            prob[i] = 1.0;
+            delta[i] = 1.0;
+            level[i] = 0;
+            frontier[frontierSize++] = static_cast<std::uint32_t>(i);
+        }
+    }
+    result.seeds = frontierSize;
+    
+    // std::cref keeps std::function from copying the closure to the heap
+    auto forChunks = [pool](std::size_t count, const auto& body) {
+        std::size_t chunks = (count + chunk - 1) / chunk;
+        if(pool && chunks > 1) {
+            pool->parallelFor(chunks, std::cref(body));
+        } else {
+            for(std::size_t c = 0; c < chunks; ++c) body(c);
+        }
+    };
+    
+    const std::size_t graphNodes = std::min(n, graph.nodes());
+    
+    for(int depth = 0; depth < maxDepth && frontierSize > 0; ++depth) {
+        const std::uint32_t current = static_cast<std::uint32_t>(depth);
+        ArenaScope levelScratch;
+        
+        // Expand: out-neighbours of the frontier, deduplicated by mark. Each
+        // chunk writes into its own slice, sized by its out-degree sum.
+        std::size_t chunks = (frontierSize + chunk - 1) / chunk;
+        std::uint64_t* slice = levelScratch.get().allocateArray<std::uint64_t>(chunks + 1);
+        std::size_t* found = levelScratch.get().allocateArray<std::size_t>(chunks);
+        slice[0] = 0;
+        for(std::size_t c = 0; c < chunks; ++c) {
+            std::uint64_t degree = 0;
+            std::size_t end = std::min(frontierSize, (c + 1) * chunk);
+            for(std::size_t f = c * chunk; f < end; ++f) {
+                std::uint32_t u = frontier[f];
+                if(u < graphNodes) degree += graph.outEnd(u) - graph.outBegin(u);
+            }
+            slice[c + 1] = slice[c] + degree;
+        }
+        std::uint32_t* reached = levelScratch.get().allocateArray<std::uint32_t>(slice[chunks]);
+        
+        forChunks(frontierSize, [&](std::size_t c) {
+            std::size_t end = std::min(frontierSize, (c + 1) * chunk);
+            std::uint32_t* out = reached + slice[c];
+            std::size_t count = 0;
+            for(std::size_t f = c * chunk; f < end; ++f) {
+                std::uint32_t u = frontier[f];
+                if(u >= graphNodes) continue;
+                for(std::uint64_t e = graph.outBegin(u); e < graph.outEnd(u); ++e) {
+                    std::uint32_t v = graph.outTarget(e);
+                    if(v >= n || prob[v] >= 1.0) continue;
+                    std::uint32_t seen = mark[v].load(std::memory_order_relaxed);
+                    if(seen != current && 
+                       mark[v].compare_exchange_strong(seen, current, std::memory_order_relaxed)) {
+                        out[count++] = v;
+                    }
+                }
+            }
+            found[c] = count;
+        });
+        std::size_t candidateCount = 0;
+        for(std::size_t c = 0; c < chunks; ++c) {
+            std::copy(reached + slice[c], reached + slice[c] + found[c], candidates + candidateCount);
+            candidateCount += found[c];
+        }
+        
+        // Pull: each candidate combines its parents that failed this level
+        forChunks(candidateCount, [&](std::size_t c) {
+            std::size_t end = std::min(candidateCount, (c + 1) * chunk);
+            for(std::size_t i = c * chunk; i < end; ++i) {
+                std::uint32_t v = candidates[i];
+                double survive = 1.0;
+                for(std::uint64_t e = graph.inBegin(v); e < graph.inEnd(v); ++e) {
+                    std::uint32_t u = graph.inSource(e);
+                    if(u < n && level[u] == current) {
+                        survive *= 1.0 - graph.inWeight(e) * delta[u];
+                    }
+                }
+                double updated = 1.0 - (1.0 - prob[v]) * survive;
+                nextProb[i] = updated;
+                nextDelta[i] = updated - prob[v];
+            }
+        });
+        
+        // Commit, keeping only candidates whose new mass is significant
+        frontierSize = 0;
+        for(std::size_t i = 0; i < candidateCount; ++i) {
+            std::uint32_t v = candidates[i];
+            prob[v] = nextProb[i];
+            if(nextDelta[i] > epsilon) {
+                delta[v] = nextDelta[i];
+                level[v] = current + 1;
+                frontier[frontierSize++] = v;
+            }
+        }
+        result.levels = depth + 1;
+    }
+    
+    for(std::size_t i = 0; i < n; ++i) {
+        if(health[i] >= 30.0) result.expectedAdditional += prob[i];
+    }
+    return result;
+}
+
+// Philox4x32-10 counter-based generator (Salmon et al., SC'11). Output is a
+// pure function of (key, counter), so every trial owns an independent,
+// reproducible stream regardless of which thread runs it.
+class PhiloxStream {
+private:
+    std::uint32_t key[2];
+    std::uint32_t counter[4];
+    std::uint32_t output[4];
+    int used = 4;
+    
+    void generate() {
+        std::uint32_t c[4] = {counter[0], counter[1], counter[2], counter[3]};
+        std::uint32_t k0 = key[0], k1 = key[1];
+        for(int round = 0; round < 10; ++round) {
+            std::uint64_t p0 = std::uint64_t(0xD2511F53u) * c[0];
+            std::uint64_t p1 = std::uint64_t(0xCD9E8D57u) * c[2];
+            std::uint32_t n0 = std::uint32_t(p1 >> 32) ^ c[1] ^ k0;
+            std::uint32_t n2 = std::uint32_t(p0 >> 32) ^ c[3] ^ k1;
+            c[0] = n0;
+            c[1] = std::uint32_t(p1);
+            c[2] = n2;
+            c[3] = std::uint32_t(p0);
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        std::copy(c, c + 4, output);
+        if(++counter[2] == 0) ++counter[3];
+        used = 0;
+    }
+
+public:
+    // Stream `stream` of generator `seed`
+    PhiloxStream(std::uint64_t seed, std::uint64_t stream) {
+        key[0] = std::uint32_t(seed);
+        key[1] = std::uint32_t(seed >> 32);
+        counter[0] = std::uint32_t(stream);
+        counter[1] = std::uint32_t(stream >> 32);
+        counter[2] = 0;
+        counter[3] = 0;
+    }
+    
+    std::uint64_t next64() {
+        if(used == 4) generate();
+        std::uint64_t value = (std::uint64_t(output[used]) << 32) | output[used + 1];
+        used += 2;
+        return value;
+    }
+    
+    // Uniform on (0, 1): 52 random bits, centred in their interval
+    double uniform() {
+        return (double(next64() >> 12) + 0.5) * 0x1.0p-52;
+    }
+    
+    // n uniforms (n even), bit-identical to n calls of uniform() on a fresh
+    // block boundary. Whole counter blocks are evaluated a vector at a time.
+    void fillUniform(double* out, std::size_t n) {
+        std::size_t i = 0;
+        std::uint64_t block = std::uint64_t(counter[3]) << 32 | counter[2];
+#if defined(__AVX512F__)
+        const __m512i mask32 = _mm512_set1_epi64(0xFFFFFFFFLL);
+        const __m512i mul0 = _mm512_set1_epi64(0xD2511F53LL);
+        const __m512i mul1 = _mm512_set1_epi64(0xCD9E8D57LL);
+        const __m512i expBits = _mm512_set1_epi64(0x4330000000000000LL);
+        const __m512d two52 = _mm512_set1_pd(0x1.0p52);
+        const __m512i lo = _mm512_set_epi64(11, 3, 10, 2, 9, 1, 8, 0);
+        const __m512i hi = _mm512_set_epi64(15, 7, 14, 6, 13, 5, 12, 4);
+        auto toUniform = [&](__m512i bits) {
+            __m512d m = _mm512_sub_pd(_mm512_castsi512_pd(
+                _mm512_or_si512(_mm512_srli_epi64(bits, 12), expBits)), two52);
+            return _mm512_mul_pd(_mm512_add_pd(m, _mm512_set1_pd(0.5)), 
+                                 _mm512_set1_pd(0x1.0p-52));
+        };
+        for(; i + 16 <= n; i += 16, block += 8) {
+            __m512i b = _mm512_add_epi64(_mm512_set1_epi64(block), 
+                                         _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0));
+            __m512i c0 = _mm512_set1_epi64(counter[0]);
+            __m512i c1 = _mm512_set1_epi64(counter[1]);
+            __m512i c2 = _mm512_and_si512(b, mask32);
+            __m512i c3 = _mm512_srli_epi64(b, 32);
+            std::uint32_t k0 = key[0], k1 = key[1];
+            for(int round = 0; round < 10; ++round) {
+                __m512i p0 = _mm512_mul_epu32(c0, mul0);
+                __m512i p1 = _mm512_mul_epu32(c2, mul1);
+                c0 = _mm512_xor_si512(_mm512_xor_si512(_mm512_srli_epi64(p1, 32), c1),
+                                      _mm512_set1_epi64(k0));
+                c2 = _mm512_xor_si512(_mm512_xor_si512(_mm512_srli_epi64(p0, 32), c3),
+                                      _mm512_set1_epi64(k1));
+                c1 = _mm512_and_si512(p1, mask32);
+                c3 = _mm512_and_si512(p0, mask32);
+                k0 += 0x9E3779B9u;
+                k1 += 0xBB67AE85u;
+            }
+            __m512d a = toUniform(_mm512_or_si512(_mm512_slli_epi64(c0, 32), c1));
+            __m512d d = toUniform(_mm512_or_si512(_mm512_slli_epi64(c2, 32), c3));
+            _mm512_storeu_pd(out + i, _mm512_permutex2var_pd(a, lo, d));
+            _mm512_storeu_pd(out + i + 8, _mm512_permutex2var_pd(a, hi, d));
+        }
+#elif defined(__AVX2__) && defined(__FMA__)
+        const __m256i mask32 = _mm256_set1_epi64x(0xFFFFFFFFLL);
+        const __m256i mul0 = _mm256_set1_epi64x(0xD2511F53LL);
+        const __m256i mul1 = _mm256_set1_epi64x(0xCD9E8D57LL);
+        const __m256i expBits = _mm256_set1_epi64x(0x4330000000000000LL);
+        const __m256d two52 = _mm256_set1_pd(0x1.0p52);
+        auto toUniform = [&](__m256i bits) {
+            __m256d m = _mm256_sub_pd(_mm256_castsi256_pd(
+                _mm256_or_si256(_mm256_srli_epi64(bits, 12), expBits)), two52);
+            return _mm256_mul_pd(_mm256_add_pd(m, _mm256_set1_pd(0.5)), 
+                                 _mm256_set1_pd(0x1.0p-52));
+        };
+        for(; i + 8 <= n; i += 8, block += 4) {
+            __m256i b = _mm256_add_epi64(_mm256_set1_epi64x(static_cast<long long>(block)), 
+                                         _mm256_set_epi64x(3, 2, 1, 0));
+            __m256i c0 = _mm256_set1_epi64x(counter[0]);
+            __m256i c1 = _mm256_set1_epi64x(counter[1]);
+            __m256i c2 = _mm256_and_si256(b, mask32);
+            __m256i c3 = _mm256_srli_epi64(b, 32);
+            std::uint32_t k0 = key[0], k1 = key[1];
+            for(int round = 0; round < 10; ++round) {
+                __m256i p0 = _mm256_mul_epu32(c0, mul0);
+                __m256i p1 = _mm256_mul_epu32(c2, mul1);
+                c0 = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p1, 32), c1),
+                                      _mm256_set1_epi64x(k0));
+                c2 = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p0, 32), c3),
+                                      _mm256_set1_epi64x(k1));
+                c1 = _mm256_and_si256(p1, mask32);
+                c3 = _mm256_and_si256(p0, mask32);
+                k0 += 0x9E3779B9u;
+                k1 += 0xBB67AE85u;
+            }
+            __m256d a = toUniform(_mm256_or_si256(_mm256_slli_epi64(c0, 32), c1));
+            __m256d d = toUniform(_mm256_or_si256(_mm256_slli_epi64(c2, 32), c3));
+            __m256d even = _mm256_unpacklo_pd(a, d);
+            __m256d odd = _mm256_unpackhi_pd(a, d);
+            _mm256_storeu_pd(out + i, _mm256_permute2f128_pd(even, odd, 0x20));
+            _mm256_storeu_pd(out + i + 4, _mm256_permute2f128_pd(even, odd, 0x31));
+        }
+#endif
+        counter[2] = std::uint32_t(block);
+        counter[3] = std::uint32_t(block >> 32);
+        used = 4;
+        for(; i < n; ++i) {
+            out[i] = uniform();
+        }
+    }
+};
+
+// Fixed-range histogram with exact running moments. Memory is set by the bin
+// count, not the sample count, and two histograms merge exactly, so
+// per-task partials combine into the same answer at any thread count.
+class QuantileHistogram {
+private:
+    double lo = 0.0;
+    double width = 1.0;
+    std::vector<std::uint64_t> bins;
+    std::uint64_t samples = 0;
+    CompensatedSum sum;
+    CompensatedSum sumSquares;
+    double minimum = std::numeric_limits<double>::infinity();
+    double maximum = -std::numeric_limits<double>::infinity();
+
+public:
+    QuantileHistogram() = default;
+    
+    QuantileHistogram(double low, double high, std::size_t binCount)
+        : lo(low), width((high - low) / binCount), bins(binCount, 0) {}
+    
+    void add(double x) {
+        double pos = (x - lo) / width;
+        std::size_t bin = pos <= 0.0 ? 0 : std::min(bins.size() - 1, static_cast<std::size_t>(pos));
+        bins[bin]++;
+        samples++;
+        sum.add(x);
+        sumSquares.add(x * x);
+        minimum = std::min(minimum, x);
+        maximum = std::max(maximum, x);
+    }
+    
+    void merge(const QuantileHistogram& other) {
+        for(std::size_t i = 0; i < bins.size(); ++i) {
+            bins[i] += other.bins[i];
+        }
+        samples += other.samples;
+        sum.add(other.sum.value());
+        sumSquares.add(other.sumSquares.value());
+        minimum = std::min(minimum, other.minimum);
+        maximum = std::max(maximum, other.maximum);
+    }
+    
+    std::uint64_t count() const { return samples; }
+    double min() const { return minimum; }
+    double max() const { return maximum; }
+    
+    double mean() const {
+        return samples ? sum.value() / samples : 0.0;
+    }
+    
+    double stddev() const {
+        if(samples < 2) return 0.0;
+        double m = mean();
+        double var = (sumSquares.value() - samples * m * m) / (samples - 1);
+        return std::sqrt(std::max(var, 0.0));
+    }
+    
+    // Linear interpolation inside the bin holding the q-th sample, clamped
+    // to the observed range
+    double quantile(double q) const {
+        if(samples == 0) return 0.0;
+        double target = q * samples;
+        std::uint64_t seen = 0;
+        for(std::size_t i = 0; i < bins.size(); ++i) {
+            if(bins[i] == 0) continue;
+            if(seen + bins[i] >= target) {
+                double frac = (target - seen) / bins[i];
+                double x = lo + (i + frac) * width;
+                return std::min(maximum, std::max(minimum, x));
+            }
+            seen += bins[i];
+        }
+        return maximum;
+    }
+};
+
+struct QuantileSummary {
+    double mean;
+    double stddev;
+    double min;
+    double max;
+    double p05;
+    double p50;
+    double p95;
+    double p99;
+    
+    static QuantileSummary from(const QuantileHistogram& h) {
+        return {h.mean(), h.stddev(), h.min(), h.max(),
+                h.quantile(0.05), h.quantile(0.50), h.quantile(0.95), h.quantile(0.99)};
+    }
+};
+
+struct MonteCarloConfig {
+    std::uint64_t trials = 100000;
+    double horizon = 1000.0;        // hours simulated per trial
+    int crews = 3;                  // parallel repair capacity
+    double meanRepairTime = 6.0;    // hours, exponentially distributed
+    std::uint64_t seed = 1;
+};
+
+struct MonteCarloResult {
+    std::uint64_t trials;
+    QuantileSummary availability;   // time-averaged fraction of fleet up
+    QuantileSummary failures;       // sensors failing within the horizon
+    QuantileSummary backlog;        // sensors still down at the horizon
+};
+
+// Trials are split into a fixed number of contiguous tasks (independent of
+// the pool size) whose histograms are merged in task order
+constexpr std::size_t monteCarloTasks = 32;
+constexpr std::size_t availabilityBins = 16384;
+
+// Fleet lifetime Monte Carlo. Each trial draws an Erlang(k, rate) lifetime
+// per sensor as -log(U1 * ... * Uk) / rate (sensors already below 30% health
+// start failed), then repairs failures first-come first-served on `crews`
+// servers with exponential repair times. A repaired sensor is assumed not to
+// fail again within the horizon.
+inline MonteCarloResult simulateFleetLifetimes(const FleetColumns& c, const double* health,
+                                               const MonteCarloConfig& config, ThreadPool* pool) {
+    const std::size_t n = c.count;
+    const std::size_t countBins = std::min<std::size_t>(n + 1, 4096);
+    const std::size_t tasks = std::max<std::size_t>(1, 
+        std::min<std::uint64_t>(monteCarloTasks, config.trials));
+    const double horizon = config.horizon;
+    const std::size_t crews = static_cast<std::size_t>(std::max(config.crews, 1));
+    
+    ArenaScope scratch;
+    ScratchVector<double> negInvRate(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        negInvRate[i] = c.failureRate[i] > 0.0 ? -1.0 / c.failureRate[i] : 0.0;
+    }
+    
+    struct Partial {
+        QuantileHistogram availability, failures, backlog;
+    };
+    std::vector<Partial> partials(tasks);
+    
+    auto runTask = [&](std::size_t task) {
+        Partial& part = partials[task];
+        part.availability = QuantileHistogram(0.0, 1.0, availabilityBins);
+        part.failures = QuantileHistogram(-0.5, n + 0.5, countBins);
+        part.backlog = QuantileHistogram(-0.5, n + 0.5, countBins);
+        
+        ArenaScope scratch;
+        ScratchVector<double> lifetime(n);
+        ScratchVector<double> failTimes;
+        ScratchVector<double> crewFree(crews);
+        failTimes.reserve(n);
+        std::uint64_t first = config.trials * task / tasks;
+        std::uint64_t last = config.trials * (task + 1) / tasks;
+        
+        for(std::uint64_t trial = first; trial < last; ++trial) {
+            PhiloxStream rng(config.seed, trial);
+            
+            for(std::size_t i = 0; i < n; ++i) {
+                double product = 1.0;
+                for(int s = 0; s < c.kStages[i]; ++s) {
+                    product *= rng.uniform();
+                }
+                lifetime[i] = std::max(product, std::numeric_limits<double>::min());
+            }
+            simd::logArray(lifetime.data(), n, lifetime.data());
+            
+            failTimes.clear();
+            for(std::size_t i = 0; i < n; ++i) {
+                double t = (health[i] < 30.0) ? 0.0
+                         : (negInvRate[i] != 0.0) ? lifetime[i] * negInvRate[i]
+                         : std::numeric_limits<double>::infinity();
+                if(t < horizon) failTimes.push_back(t);
+            }
+            std::sort(failTimes.begin(), failTimes.end());
+            
+            // FCFS repair: each failure takes the crew that frees up first
+            std::fill(crewFree.begin(), crewFree.end(), 0.0);
+            double downtime = 0.0;
+            std::size_t stillDown = 0;
+            for(double t : failTimes) {
+                auto crew = std::min_element(crewFree.begin(), crewFree.end());
+                double finish = std::max(t, *crew) - config.meanRepairTime * std::log(rng.uniform());
+                *crew = finish;
+                if(finish >= horizon) {
+                    stillDown++;
+                    downtime += horizon - t;
+                } else {
+                    downtime += finish - t;
+                }
+            }
+            
+            double up = n ? 1.0 - downtime / (static_cast<double>(n) * horizon) : 1.0;
+            part.availability.add(up);
+            part.failures.add(static_cast<double>(failTimes.size()));
+            part.backlog.add(static_cast<double>(stillDown));
+        }
+    };
+    
+    if(pool && tasks > 1) {
+        pool->parallelFor(tasks, runTask);
+    } else {
+        for(std::size_t t = 0; t < tasks; ++t) runTask(t);
+    }
+    
+    for(std::size_t t = 1; t < tasks; ++t) {
+        partials[0].availability.merge(partials[t].availability);
+        partials[0].failures.merge(partials[t].failures);
+        partials[0].backlog.merge(partials[t].backlog);
+    }
+    
+    MonteCarloResult result;
+    result.trials = config.trials;
+    result.availability = QuantileSummary::from(partials[0].availability);
+    result.failures = QuantileSummary::from(partials[0].failures);
+    result.backlog = QuantileSummary::from(partials[0].backlog);
+    return result;
+}
+
+// Pending simulation event: 16 bytes
+struct SimEvent {
+    double time;
+    std::uint32_t sensor;
+    std::uint32_t kind;
+};
+
+// Implicit 4-ary min-heap on event time over one contiguous, reused pool.
+// The pool is 64-byte aligned and the root sits at offset 3, so the four
+// children of every node fill exactly one cache line. Three +inf sentinels
+// past the last event mean every visited node has four children, so
+// sift-down picks the smallest with a fixed, branch-free tournament. Equal
+// times pop in an unspecified but deterministic order.
+class EventHeap {
+private:
+    static constexpr std::size_t arity = 4;
+    static constexpr std::size_t pad = 3;
+    static constexpr std::size_t sentinels = arity - 1;
+    static constexpr SimEvent never{std::numeric_limits<double>::infinity(), 0, 0};
+    AlignedVector<SimEvent> pool = AlignedVector<SimEvent>(pad + sentinels, never);
+    
+    SimEvent* at() { return pool.data() + pad; }
+
+public:
+    void reserve(std::size_t n) { pool.reserve(pad + n + sentinels); }
+    void clear() { pool.assign(pad + sentinels, never); }
+    std::size_t size() const { return pool.size() - pad - sentinels; }
+    bool empty() const { return size() == 0; }
+    const SimEvent& top() const { return pool[pad]; }
+    
+    void push(const SimEvent& e) {
+        std::size_t i = size();
+        pool.push_back(never);
+        SimEvent* h = at();
+        while(i > 0) {
+            std::size_t parent = (i - 1) / arity;
+            if(!(e.time < h[parent].time)) break;
+            h[i] = h[parent];
+            i = parent;
+        }
+        h[i] = e;
+    }
+    
+    SimEvent pop() {
+        SimEvent result = top();
+        std::size_t last = size() - 1;
+        SimEvent moved = at()[last];
+        at()[last] = never;
+        pool.pop_back();
+        if(last > 0) siftDown(moved);
+        return result;
+    }
+    
+    // Replace the top with e; cheaper than pop() followed by push()
+    void replaceTop(const SimEvent& e) {
+        siftDown(e);
+    }
+
+private:
+    void siftDown(const SimEvent& e) {
+        SimEvent* h = at();
+        const std::size_t n = size();
+        std::size_t i = 0;
+        for(;;) {
+            std::size_t first = i * arity + 1;
+            if(first >= n) break;
+            const SimEvent* c = h + first;
+            std::size_t a = c[1].time < c[0].time ? 1 : 0;
+            std::size_t b = c[3].time < c[2].time ? 3 : 2;
+            std::size_t best = c[b].time < c[a].time ? b : a;
+            if(!(c[best].time < e.time)) break;
+            h[i] = c[best];
+            i = first + best;
+        }
+        h[i] = e;
+    }
+};
+
+// Unit-mean exponential variates generated a block at a time with the
+// vectorized log
+class ExponentialSource {
+private:
+    PhiloxStream rng;
+    AlignedVector<double> buffer;
+    std::size_t next = simd::blockSize;
+    
+    void refill() {
+        rng.fillUniform(buffer.data(), buffer.size());
+        simd::logArray(buffer.data(), buffer.size(), buffer.data());
+        next = 0;
+    }
+
+public:
+    ExponentialSource(std::uint64_t seed, std::uint64_t stream) 
+        : rng(seed, stream), buffer(simd::blockSize) {}
+    
+    double next1() {
+        if(next == simd::blockSize) refill();
+        return -buffer[next++];
+    }
+    
+    double uniform() {
+        return rng.uniform();
+    }
+};
+
+enum class ServiceDistribution : std::uint8_t {
+    DETERMINISTIC,     // cv = 0
+    ERLANG,            // cv = 1 / sqrt(serviceStages)
+    EXPONENTIAL,       // cv = 1
+    HYPEREXPONENTIAL   // balanced two-phase, cv = serviceCV > 1
+};
+
+constexpr std::size_t maintenancePriorityClasses = 3;
+
+struct MaintenanceSimConfig {
+    double duration = 100000.0;     // simulated hours
+    double warmup = 1000.0;         // hours excluded from the statistics
+    int crews = 3;
+    double meanRepairTime = 6.0;    // hours
+    ServiceDistribution service = ServiceDistribution::EXPONENTIAL;
+    int serviceStages = 2;
+    double serviceCV = 2.0;
+    // Priority class per SensorType (0 is served first), non-preemptive
+    std::array<std::uint8_t, 3> typePriority{{0, 1, 2}};
+    double waitHistogramMax = 200.0; // hours; longer waits land in the last bin
+    std::uint64_t seed = 1;
+};
+
+struct MaintenanceSimResult {
+    std::uint64_t events;
+    std::uint64_t repairs;
+    double throughput;              // repairs per hour after warmup
+    double utilization;             // mean fraction of crews busy
+    double meanQueueLength;         // time-averaged sensors waiting
+    QuantileSummary wait;           // hours from failure to repair start
+    std::array<double, maintenancePriorityClasses> meanWaitByClass;
+    std::array<std::uint64_t, maintenancePriorityClasses> repairsByClass;
+};
+
+// Discrete-event simulation of the closed maintenance loop: each sensor
+// fails after an exponential time at its own failure rate, waits for a
+// crew in its priority class (FIFO within a class), and returns to service
+// after a repair drawn from the configured distribution. Sensors below 30%
+// health start the run failed.
+inline MaintenanceSimResult simulateMaintenanceQueue(const FleetColumns& c, const double* health,
+                                                     const MaintenanceSimConfig& config) {
+    enum : std::uint32_t { FAILURE, REPAIRED };
+    constexpr std::size_t classes = maintenancePriorityClasses;
+    const std::size_t n = c.count;
+    const double mean = config.meanRepairTime;
+    
+    ExponentialSource draw(config.seed, 0);
+    auto serviceTime = [&]() {
+        switch(config.service) {
+            case ServiceDistribution::DETERMINISTIC:
+                return mean;
+            case ServiceDistribution::ERLANG: {
+                int k = std::max(config.serviceStages, 1);
+                double sum = 0.0;
+                for(int i = 0; i < k; ++i) sum += draw.next1();
+                return sum * mean / k;
+            }
+            case ServiceDistribution::HYPEREXPONENTIAL: {
+                double cv2 = std::max(config.serviceCV * config.serviceCV, 1.0);
+                double p = 0.5 * (1.0 + std::sqrt((cv2 - 1.0) / (cv2 + 1.0)));
+                double branchMean = (draw.uniform() <= p) ? mean / (2.0 * p) 
+                                                          : mean / (2.0 * (1.0 - p));
+                return draw.next1() * branchMean;
+            }
+            default:
+                return draw.next1() * mean;
+        }
+    };
+    
+    ArenaScope scratch;
+    ScratchVector<double> invRate(n);
+    ScratchVector<std::uint8_t> classOf(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        invRate[i] = c.failureRate[i] > 0.0 ? 1.0 / c.failureRate[i] : 0.0;
+        classOf[i] = std::min<std::uint8_t>(
+            config.typePriority[static_cast<std::size_t>(c.types[i])], classes - 1);
+    }
+    
+    // Each sensor waits at most once at a time, so a ring of n per class suffices
+    ScratchVector<std::uint32_t> rings(classes * std::max<std::size_t>(n, 1));
+    std::array<std::size_t, classes> head{}, tail{};
+    ScratchVector<double> failedAt(n, 0.0);
+    std::size_t waiting = 0;
+    
+    EventHeap calendar;
+    calendar.reserve(n + 1);
+    for(std::size_t i = 0; i < n; ++i) {
+        std::uint32_t id = static_cast<std::uint32_t>(i);
+        if(health[i] < 30.0) {
+            calendar.push({0.0, id, FAILURE});
+        } else if(invRate[i] > 0.0) {
+            calendar.push({draw.next1() * invRate[i], id, FAILURE});
+        }
+    }
+    
+    MaintenanceSimResult result{};
+    QuantileHistogram waits(0.0, config.waitHistogramMax, availabilityBins);
+    std::array<CompensatedSum, classes> classWait;
+    CompensatedSum queueArea, busyArea;
+    int busy = 0;
+    double last = config.warmup;
+    const double end = config.duration;
+    
+    // Start a repair of sensor id at time t, reusing the top heap slot
+    auto startRepair = [&](std::uint32_t id, double t, bool reuseTop) {
+        if(t >= config.warmup) {
+            double wait = t - failedAt[id];
+            waits.add(wait);
+            classWait[classOf[id]].add(wait);
+            result.repairsByClass[classOf[id]]++;
+        }
+        SimEvent done{t + serviceTime(), id, REPAIRED};
+        if(reuseTop) calendar.replaceTop(done);
+        else calendar.push(done);
+    };
+    
+    while(!calendar.empty()) {
+        const SimEvent e = calendar.top();
+        if(e.time > end) break;
+        result.events++;
+        
+        if(e.time > last) {
+            queueArea.add(waiting * (e.time - last));
+            busyArea.add(busy * (e.time - last));
+            last = e.time;
+        }
+        
+        if(e.kind == FAILURE) {
+            failedAt[e.sensor] = e.time;
+            if(busy < config.crews) {
+                busy++;
+                startRepair(e.sensor, e.time, true);
+            } else {
+                std::size_t cls = classOf[e.sensor];
+                rings[cls * n + tail[cls]] = e.sensor;
+                tail[cls] = (tail[cls] + 1 == n) ? 0 : tail[cls] + 1;
+                waiting++;
+                calendar.pop();
+            }
+        } else {
+            if(e.time >= config.warmup) result.repairs++;
+            double next = e.time + draw.next1() * invRate[e.sensor];
+            if(invRate[e.sensor] > 0.0) calendar.replaceTop({next, e.sensor, FAILURE});
+            else calendar.pop();
+            
+            // Hand the freed crew to the highest-priority waiting sensor
+            busy--;
+            if(waiting > 0) {
+                for(std::size_t cls = 0; cls < classes; ++cls) {
+                    if(head[cls] == tail[cls]) continue;
+                    std::uint32_t id = rings[cls * n + head[cls]];
+                    head[cls] = (head[cls] + 1 == n) ? 0 : head[cls] + 1;
+                    waiting--;
+                    busy++;
+                    startRepair(id, e.time, false);
+                    break;
+                }
+            }
+        }
+    }
+    
+    double span = std::max(end - config.warmup, 0.0);
+    if(end > last) {
+        queueArea.add(waiting * (end - last));
+        busyArea.add(busy * (end - last));
+    }
+    if(span > 0.0) {
+        result.throughput = result.repairs / span;
+        result.utilization = busyArea.value() / (span * std::max(config.crews, 1));
+        result.meanQueueLength = queueArea.value() / span;
+    }
+    result.wait = QuantileSummary::from(waits);
+    for(std::size_t cls = 0; cls < classes; ++cls) {
+        result.meanWaitByClass[cls] = result.repairsByClass[cls] 
+            ? classWait[cls].value() / result.repairsByClass[cls] : 0.0;
+    }
+    return result;
+}
+
+// Right-censored lifetime observations for model fitting, streamed in and
+// kept as log times in fixed-size chunks. Cause 0 marks a unit still running
+// at that age (censored), cause c in 1..maxFailureModes a failure by mode c.
+constexpr int maxFailureModes = 4;
+constexpr std::size_t lifetimeChunk = 16384;
+
+class LifetimeSample {
+public:
+    struct Chunk {
+        std::vector<double> logTime;
+        std::vector<std::uint8_t> cause;
+    };
+
+private:
+    std::vector<Chunk> chunks;
+    std::array<std::size_t, maxFailureModes + 1> counts{};
+    std::array<CompensatedSum, maxFailureModes + 1> logSums;
+    double maxLog = -std::numeric_limits<double>::infinity();
+    std::size_t rejectedCount = 0;
+
+public:
+    // Non-positive or non-finite ages and unknown causes are rejected
+    void add(double age, int cause) {
+        if(!(age > 0.0) || !std::isfinite(age) || cause < 0 || cause > maxFailureModes) {
+            rejectedCount++;
+            return;
+        }
+        if(chunks.empty() || chunks.back().logTime.size() == lifetimeChunk) {
+            chunks.emplace_back();
+            chunks.back().logTime.reserve(lifetimeChunk);
+            chunks.back().cause.reserve(lifetimeChunk);
+        }
+        double logAge = std::log(age);
+        chunks.back().logTime.push_back(logAge);
+        chunks.back().cause.push_back(static_cast<std::uint8_t>(cause));
+        counts[cause]++;
+        logSums[cause].add(logAge);
+        maxLog = std::max(maxLog, logAge);
+    }
+    
+    // causes may be null: every observation is then a mode-1 failure
+    void add(const double* ages, const std::uint8_t* causes, std::size_t n) {
+        for(std::size_t i = 0; i < n; ++i) {
+            add(ages[i], causes ? causes[i] : 1);
+        }
+    }
+    
+    std::size_t size() const {
+        std::size_t total = 0;
+        for(std::size_t c : counts) total += c;
+        return total;
+    }
+    
+    std::size_t failures(int mode) const { return counts[mode]; }
+    std::size_t censored() const { return counts[0]; }
+    std::size_t rejected() const { return rejectedCount; }
+    double logAgeSum(int mode) const { return logSums[mode].value(); }
+    double maxLogAge() const { return maxLog; }
+    const std::vector<Chunk>& data() const { return chunks; }
+    
+    // Highest failure mode present
+    int modes() const {
+        int highest = 0;
+        for(int c = 1; c <= maxFailureModes; ++c) {
+            if(counts[c] > 0) highest = c;
+        }
+        return highest;
+    }
+};
+
+struct WeibullFit {
+    WeibullModel model{1.0, std::numeric_limits<double>::infinity()};
+    std::size_t failures = 0;
+    std::size_t observations = 0;
+    double logLikelihood = 0.0;
+    int iterations = 0;
+    bool converged = false;
+};
+
+struct CompetingRiskFit {
+    CompetingRiskModel model;
+    std::vector<WeibullFit> modes;    // modes[c - 1] for failure mode c
+    double logLikelihood = 0.0;
+};
+
+constexpr int weibullMaxIterations = 60;
+constexpr double weibullTolerance = 1e-10;
+constexpr double weibullMaxShape = 100.0;
+
+// Maximum-likelihood Weibull fits of the failure modes firstMode.. on
+// right-censored data. With cause labels the competing-risk likelihood
+// splits per mode, each mode treating the others' failures as censored. Per
+// mode the scale is profiled out, eta^beta = sum t^beta / r, leaving
+//   g(beta) = 1/beta + mean(log t | failures) - S1/S0 = 0,
+//   Sk = sum_i (log t_i)^k t_i^beta over all observations,
+// which is decreasing in beta; it is solved by Newton steps kept inside a
+// shrinking bracket. Each iteration is one pass over the chunks, which run
+// on the pool when given and combine in chunk order, so the fit does not
+// depend on the thread count. Times are taken relative to the largest so
+// t^beta cannot overflow.
+inline std::vector<WeibullFit> fitWeibullModes(const LifetimeSample& sample, int firstMode,
+                                               int modeCount, ThreadPool* pool) {
+    const auto& chunks = sample.data();
+    const std::size_t n = sample.size();
+    const double shift = sample.maxLogAge();
+    
+    struct ModeState {
+        double beta = 1.0;
+        double lo = 0.0;
+        double hi = weibullMaxShape;
+        double meanLog = 0.0;    // mean shifted log age over the mode's failures
+        double s0 = 0.0;         // S0 at the last evaluated shape
+        double evaluated = 1.0;
+        bool active = false;
+    };
+    std::vector<WeibullFit> fits(modeCount);    // fits[i] for mode firstMode + i
+    std::vector<ModeState> state(modeCount);
+    for(int mode = 0; mode < modeCount; ++mode) {
+        std::size_t r = sample.failures(firstMode + mode);
+        fits[mode].failures = r;
+        fits[mode].observations = n;
+        state[mode].active = r > 0;
+        if(r > 0) state[mode].meanLog = sample.logAgeSum(firstMode + mode) / r - shift;
+    }
+    
+    struct Moments {
+        std::array<double, maxFailureModes> s0, s1, s2;
+    };
+    std::vector<Moments> partials(chunks.size());
+    
+    auto runChunk = [&](std::size_t chunk) {
+        const std::vector<double>& logTime = chunks[chunk].logTime;
+        double v[simd::blockSize];
+        double w[simd::blockSize];
+        Moments& part = partials[chunk];
+        part.s0.fill(0.0);
+        part.s1.fill(0.0);
+        part.s2.fill(0.0);
+        for(std::size_t base = 0; base < logTime.size(); base += simd::blockSize) {
+            std::size_t m = std::min(simd::blockSize, logTime.size() - base);
+            for(std::size_t j = 0; j < m; ++j) {
+                v[j] = logTime[base + j] - shift;
+            }
+            for(int mode = 0; mode < modeCount; ++mode) {
+                if(!state[mode].active) continue;
+                const double beta = state[mode].beta;
+                for(std::size_t j = 0; j < m; ++j) {
+                    w[j] = beta * v[j];
+                }
+                simd::expArray(w, m, w);
+                double s0 = 0.0, s1 = 0.0, s2 = 0.0;
+                for(std::size_t j = 0; j < m; ++j) {
+                    s0 += w[j];
+                    s1 += w[j] * v[j];
+                    s2 += w[j] * v[j] * v[j];
+                }
+                part.s0[mode] += s0;
+                part.s1[mode] += s1;
+                part.s2[mode] += s2;
+            }
+        }
+    };
+    
+    for(int iteration = 1; iteration <= weibullMaxIterations; ++iteration) {
+        bool any = false;
+        for(const auto& mode : state) any = any || mode.active;
+        if(!any) break;
+        
+        if(pool && chunks.size() > 1) {
+            pool->parallelFor(chunks.size(), runChunk);
+        } else {
+            for(std::size_t chunk = 0; chunk < chunks.size(); ++chunk) runChunk(chunk);
+        }
+        
+        for(int mode = 0; mode < modeCount; ++mode) {
+            ModeState& st = state[mode];
+            if(!st.active) continue;
+            double s0 = 0.0, s1 = 0.0, s2 = 0.0;
+            for(const Moments& part : partials) {
+                s0 += part.s0[mode];
+                s1 += part.s1[mode];
+                s2 += part.s2[mode];
+            }
+            const double mean = s1 / s0;
+            const double g = 1.0 / st.beta + st.meanLog - mean;
+            const double slope = -1.0 / (st.beta * st.beta) - (s2 / s0 - mean * mean);
+            st.s0 = s0;
+            st.evaluated = st.beta;
+            fits[mode].iterations = iteration;
+            
+            if(g > 0.0) st.lo = st.beta; else st.hi = st.beta;
+            double next = st.beta - g / slope;
+            if(!(next > st.lo && next < st.hi)) next = 0.5 * (st.lo + st.hi);
+            if(std::abs(next - st.beta) <= weibullTolerance * st.beta) {
+                fits[mode].converged = true;
+                st.active = false;
+            } else if(st.lo >= weibullMaxShape * (1.0 - weibullTolerance)) {
+                st.active = false;    // no finite maximum: ages all (nearly) equal
+            } else {
+                st.beta = next;
+            }
+        }
+    }
+    
+    for(int mode = 0; mode < modeCount; ++mode) {
+        const ModeState& st = state[mode];
+        WeibullFit& fit = fits[mode];
+        if(fit.failures == 0) continue;
+        const double r = static_cast<double>(fit.failures);
+        const double beta = st.evaluated;
+        const double logEta = shift + std::log(st.s0 / r) / beta;
+        fit.model = WeibullModel(beta, std::exp(logEta));
+        // At the profiled scale sum (t / eta)^beta equals r
+        fit.logLikelihood = r * std::log(beta) - r * beta * logEta +
+                            (beta - 1.0) * sample.logAgeSum(firstMode + mode) - r;
+    }
+    return fits;
+}
+
+// Modification epochs per granule of slots, kept separately for structural
+// changes (membership, model, location) and health changes. A cached result
+// computed at epoch E is patched by recomputing only the chunks that hold a
+// granule whose epoch is newer than E.
+class FleetEpochs {
+public:
+    enum Kind { STRUCTURE, HEALTH };
+    static constexpr std::size_t granule = 1024;
+
+private:
+    std::uint64_t counter = 0;
+    std::uint64_t latest[2] = {0, 0};
+    std::uint64_t floor[2] = {0, 0};  // any result older than this is stale everywhere
+    std::vector<std::uint64_t> changed[2];
+
+public:
+    std::uint64_t now() const {
+        return counter;
+    }
+    
+    void touch(Kind kind, std::size_t slot) {
+        const std::size_t g = slot / granule;
+        latest[kind] = ++counter;
+        if(changed[kind].size() <= g) changed[kind].resize(g + 1, 0);
+        changed[kind][g] = counter;
+    }
+    
+    void touchAll(Kind kind) {
+        latest[kind] = floor[kind] = ++counter;
+    }
+    
+    // True if nothing a result of these kinds depends on changed after epoch
+    bool unchangedSince(std::uint64_t epoch, bool health) const {
+        return latest[STRUCTURE] <= epoch && (!health || latest[HEALTH] <= epoch);
+    }
+    
+    // Chunks of chunkSize slots (a multiple of granule) among the first
+    // slotCount slots that changed after epoch, ascending; false when a bulk
+    // change means everything must be recomputed
+    bool changedSince(std::uint64_t epoch, bool health, std::size_t chunkSize, 
+                      std::size_t slotCount, std::vector<std::uint32_t>& chunks) const {
+        if(floor[STRUCTURE] > epoch || (health && floor[HEALTH] > epoch)) return false;
+        const std::size_t perChunk = chunkSize / granule;
+        const std::size_t granules = (slotCount + granule - 1) / granule;
+        for(std::size_t g = 0; g < granules; ++g) {
+            bool dirty = (g < changed[STRUCTURE].size() && changed[STRUCTURE][g] > epoch) ||
+                         (health && g < changed[HEALTH].size() && changed[HEALTH][g] > epoch);
+            if(!dirty) continue;
+            std::uint32_t chunk = static_cast<std::uint32_t>(g / perChunk);
+            if(chunks.empty() || chunks.back() != chunk) chunks.push_back(chunk);
+        }
+        return true;
+    }
+};
+
+enum class CachedMetric : std::uint8_t {
+    RELIABILITY,
+    SENSOR_STATS,
+    CASCADE_RISK
+};
+
+struct QueryKey {
+    CachedMetric metric;
+    double horizon;
+    bool regional;
+    Region region;
+    
+    bool operator==(const QueryKey& o) const {
+        if(metric != o.metric || horizon != o.horizon || regional != o.regional) return false;
+        if(!regional) return true;
+        const Region& a = region;
+        const Region& b = o.region;
+        return a.minX == b.minX && a.minY == b.minY && a.maxX == b.maxX && a.maxY == b.maxY &&
+               a.circular == b.circular && a.centerX == b.centerX && a.centerY == b.centerY &&
+               a.radius == b.radius;
+    }
+};
+
+// Mean reliability of count sensors. An empty set (a region, type or fleet
+// with no sensors) has nothing that can fail, so its reliability is 1.
+inline double meanReliability(double sum, std::size_t count) {
+    return count > 0 ? sum / static_cast<double>(count) : 1.0;
+}
+
+// One chunk's share of a cached query: reduction chunks for fleet-wide
+// results, epoch granules for regional ones
+struct QueryPartial {
+    std::uint32_t chunk;
+    std::uint32_t count;
+    double reliability;
+    HealthTally tally;
+};
+
+// Cached query result plus the per-chunk partials it was combined from,
+// in chunk order; chunks with no sensors in the query are omitted
+struct QueryEntry {
+    QueryKey key;
+    std::uint64_t epoch;
+    std::uint64_t lastUse;
+    std::vector<QueryPartial> partials;
+    std::size_t count;
+    double reliability;
+    HealthTally tally;
+    
+    void combine() {
+        count = 0;
+        double sum = 0.0;
+        tally = HealthTally();
+        for(const QueryPartial& p : partials) {
+            count += p.count;
+            sum += p.reliability;
+            tally.active += p.tally.active;
+            tally.warning += p.tally.warning;
+            tally.failed += p.tally.failed;
+            tally.cascadeFailures += p.tally.cascadeFailures;
+        }
+        reliability = meanReliability(sum, count);
+    }
+};
+
+// Small LRU of query results, safe for concurrent readers
+class QueryCache {
+private:
+    mutable std::mutex mutex;
+    std::vector<QueryEntry> entries;
+    std::size_t capacity = 16;
+    std::uint64_t clock = 0;
+
+public:
+    void setCapacity(std::size_t n) {
+        std::lock_guard<std::mutex> lock(mutex);
+        capacity = n;
+        if(entries.size() > n) entries.clear();
+    }
+    
+    std::size_t getCapacity() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return capacity;
+    }
+    
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.clear();
+    }
+    
+    // Copies the entry for key into out; false if there is none
+    bool find(const QueryKey& key, QueryEntry& out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for(QueryEntry& e : entries) {
+            if(e.key == key) {
+                e.lastUse = ++clock;
+                out = e;
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    // Cheaper probe for the common case: the cached value, if current
+    template<typename Fn>
+    bool findCurrent(const QueryKey& key, Fn&& isCurrent, QueryEntry& out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for(QueryEntry& e : entries) {
+            if(e.key == key && isCurrent(e.epoch)) {
+                e.lastUse = ++clock;
+                out.epoch = e.epoch;
+                out.count = e.count;
+                out.reliability = e.reliability;
+                out.tally = e.tally;
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    void store(QueryEntry entry) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(capacity == 0) return;
+        entry.lastUse = ++clock;
+        for(QueryEntry& e : entries) {
+            if(e.key == entry.key) {
+                if(entry.epoch >= e.epoch) e = std::move(entry);
+                return;
+            }
+        }
+        if(entries.size() < capacity) {
+            entries.push_back(std::move(entry));
+            return;
+        }
+        auto oldest = std::min_element(entries.begin(), entries.end(),
+            [](const QueryEntry& a, const QueryEntry& b) { return a.lastUse < b.lastUse; });
+        *oldest = std::move(entry);
+    }
+};
+
+// Mergeable partial of the fleet metrics at one horizon. It holds sums and
+// counts rather than means, so the shards of a partitioned fleet combine
+// exactly. FleetReliabilityManager::summarize() produces one per shard, and
+// snapshotFromSummary() turns a merged summary into a FleetSnapshot.
+struct FleetSummary {
+    struct AtRisk {
+        std::uint32_t shard;
+        std::uint64_t slot;             // slot within its shard
+        double failureProbability;
+        std::string id;
+    };
+    
+    double timeHorizon = 0.0;
+    std::uint64_t count = 0;
+    double mtbfSum = 0.0;
+    double mttfSum = 0.0;
+    double reliabilitySum = 0.0;
+    std::uint64_t active = 0;
+    std::uint64_t warning = 0;
+    std::uint64_t failed = 0;
+    std::uint64_t cascadeFailures = 0;
+    std::uint32_t topK = 0;
+    std::vector<AtRisk> atRisk;         // worst first, at most topK
+    
+    static bool worse(const AtRisk& a, const AtRisk& b) {
+        if(a.failureProbability != b.failureProbability) {
+            return a.failureProbability > b.failureProbability;
+        }
+        return a.shard < b.shard || (a.shard == b.shard && a.slot < b.slot);
+    }
+    
+    // Fold in another shard's summary; both must share the horizon and K
+    bool merge(const FleetSummary& other) {
+        if(other.timeHorizon != timeHorizon || other.topK != topK) return false;
+        count += other.count;
+        mtbfSum += other.mtbfSum;
+        mttfSum += other.mttfSum;
+        reliabilitySum += other.reliabilitySum;
+        active += other.active;
+        warning += other.warning;
+        failed += other.failed;
+        cascadeFailures += other.cascadeFailures;
+        
+        std::vector<AtRisk> merged;
+        merged.reserve(std::min<std::size_t>(topK, atRisk.size() + other.atRisk.size()));
+        auto a = atRisk.begin();
+        auto b = other.atRisk.begin();
+        while(merged.size() < topK && (a != atRisk.end() || b != other.atRisk.end())) {
+            if(b == other.atRisk.end() || (a != atRisk.end() && !worse(*b, *a))) {
+                merged.push_back(std::move(*a++));
+            } else {
+                merged.push_back(*b++);
+            }
+        }
+        atRisk.swap(merged);
+        return true;
+    }
+};
+
+// What-if grid for FleetReliabilityManager::sweepScenarios(). Each
+// multiplier scales every sensor's failure rate. The scaled fleet failure
+// rate then feeds an M/M/c repair queue at each crew size.
+struct ScenarioGrid {
+    std::vector<double> rateMultipliers{1.0};   // positive
+    std::vector<double> horizons{1000.0};
+    std::vector<int> crews{3};                  // crew sizes below 1 count as 1
+    double meanRepairTime = 6.0;                // hours, exponentially distributed
+};
+
+// Grid results, row-major by multiplier
+struct ScenarioSweep {
+    std::size_t multipliers = 0;
+    std::size_t horizons = 0;
+    std::size_t crewSizes = 0;
+    std::vector<double> reliability;    // [multiplier][horizon] mean fleet reliability
+    std::vector<double> mtbf;           // [multiplier] mean sensor MTBF, hours
+    std::vector<double> failureRate;    // [multiplier] fleet failures per hour
+    std::vector<QueueMetrics> queue;    // [multiplier][crew size]
+    
+    double reliabilityAt(std::size_t m, std::size_t h) const {
+        return reliability[m * horizons + h];
+    }
+    
+    const QueueMetrics& queueAt(std::size_t m, std::size_t c) const {
+        return queue[m * crewSizes + c];
+    }
+};
+
+enum class ExecutionMode {
+    SERIAL,
+    PARALLEL
+};
+
+// Fleet Reliability Manager
+class FleetReliabilityManager {
+public:
+    struct SensorStats {
+        int total;
+        int active;
+        int warning;
+        int failed;
+    };
+    
+    struct CascadeRisk {
+        int currentFailures;
+        double riskFactor;
+        int expectedAdditional;
+        RiskLevel riskLevel;
+        double dependencyMultiplier;
+    };
+    
+    // All fleet metrics for one time horizon
+    struct FleetSnapshot {
+        double timeHorizon;
+        double mtbf;
+        double mttf;
+        double reliability;
+        SensorStats stats;
+        CascadeRisk cascade;
+    };
+    
+    // One entry of a top-K risk ranking
+    struct AtRiskSensor {
+        std::size_t slot;
+        double failureProbability;    // 1 - R(horizon)
+    };
+    
+    // Reductions run over fixed-size chunks whose partials are combined in
+    // chunk order, so results do not depend on thread count or scheduling
+    static constexpr std::size_t reductionChunk = 64 * simd::blockSize;
+
+private:
+    // Running aggregates kept current by every mutation, so the mean and
+    // count queries are O(1)
+    struct TypeAggregates {
+        CompensatedSum mtbfSum;
+        CompensatedSum mttfSum;
+        HealthTally tally;
+        // Sensors per stage count k <= maxSpecializedStages; [0] counts the rest
+        std::array<std::size_t, maxSpecializedStages + 1> stageCount{};
+    };
+    
+    struct FleetAggregates {
+        CompensatedSum mtbfSum;
+        CompensatedSum mttfSum;
+        HealthTally tally;
+        std::array<TypeAggregates, sensorTypeCount> byType;
+    };
+    
+    FleetStore store;
+    FleetAggregates aggregates;
+    SensorIdIndex idIndex;
+    
+    // When set, queries read this read-only mapping instead of the store;
+    // the first mutation copies it into the store
+    std::shared_ptr<const MappedFleetSnapshot> mapped;
+    
+    // Live health board while concurrent health mode is active
+    std::unique_ptr<ConcurrentHealthBoard> healthBoard;
+    
+    // Compressed per-slot health time series, once enabled
+    std::unique_ptr<HealthHistory> history;
+    
+    // Slot-indexed dependency topology for cascade propagation
+    DependencyGraph dependencies;
+    
+    // Chunk modification epochs and the query results they validate
+    FleetEpochs epochs;
+    mutable QueryCache queryCache;
+    
+    // Built on the first regional query, then maintained incrementally
+    mutable SpatialGrid spatial;
+    mutable bool spatialValid = false;
+    mutable std::mutex spatialMutex;
+    
+    const SpatialGrid& spatialIndex() const {
+        std::lock_guard<std::mutex> lock(spatialMutex);
+        if(!spatialValid) {
+            spatial.build(currentColumns());
+            spatialValid = true;
+        }
+        return spatial;
+    }
+    
+    // Slots inside a region, in deterministic grid order; scratch memory,
+    // so callers hold an ArenaScope
+    ScratchVector<std::uint32_t> regionSlots(const Region& region) const {
+        ScratchVector<std::uint32_t> slots;
+        spatialIndex().forEach(region, currentColumns(), [&slots](std::uint32_t slot) {
+            slots.push_back(slot);
+        });
+        return slots;
+    }
+    
+    const double* currentHealth(std::shared_ptr<const HealthSnapshot>& pin) const {
+        if(healthBoard) {
+            pin = healthBoard->acquire();
+            return pin->health.data();
+        }
+        return currentColumns().health;
+    }
+    ExecutionMode mode = ExecutionMode::SERIAL;
+    ThreadPool* pool = nullptr;
+    NumaExecutor* numa = nullptr;       // shards PARALLEL reductions when set
+    std::size_t shardChunks = 0;        // reduction chunks laid out by the last placement
+    
+    // Apply one sensor's health to the bucket and cascade counts (sign = +/-1)
+    void countHealth(SensorType type, double health, int sign) {
+        aggregates.tally.add(health, sign);
+        aggregates.byType[static_cast<std::size_t>(type)].tally.add(health, sign);
+    }
+    
+    static std::size_t stageBucket(int k) {
+        return (k >= 1 && k <= maxSpecializedStages) ? static_cast<std::size_t>(k) : 0;
+    }
+    
+    FleetColumns currentColumns() const {
+        return mapped ? mapped->columns() : store.columns();
+    }
+    
+    void materialize() {
+        endConcurrentHealth();
+        if(!mapped) return;
+        store.assign(mapped->columns());
+        mapped.reset();
+        idIndex.rebuild(store.columns());
+        spatialValid = false;
+    }
+    
+    void countSensor(std::size_t slot, int sign) {
+        double rate = store.getFailureRate(slot);
+        int stages = store.getKStages(slot);
+        double k = static_cast<double>(stages);
+        SensorType type = store.getType(slot);
+        TypeAggregates& typed = aggregates.byType[static_cast<std::size_t>(type)];
+        if(sign > 0) {
+            aggregates.mtbfSum.add(1.0 / rate);
+            aggregates.mttfSum.add(k / rate);
+            typed.mtbfSum.add(1.0 / rate);
+            typed.mttfSum.add(k / rate);
+        } else {
+            aggregates.mtbfSum.subtract(1.0 / rate);
+            aggregates.mttfSum.subtract(k / rate);
+            typed.mtbfSum.subtract(1.0 / rate);
+            typed.mttfSum.subtract(k / rate);
+        }
+        typed.stageCount[stageBucket(stages)] += sign;
+        countHealth(type, store.getHealth(slot), sign);
+    }
+    
+    // Follow a store move: the sensor in slot from now lives in slot to.
+    // Slot numbering changes, so the slot-indexed topology is dropped.
+    void relocateSlot(std::size_t from, std::size_t to) {
+        idIndex.relocate(store.getId(to), from, to);
+        if(spatialValid) spatial.relocate(from, to);
+        if(history) history->relocate(from, to);
+        epochs.touch(FleetEpochs::STRUCTURE, from);
+        epochs.touch(FleetEpochs::STRUCTURE, to);
+        if(!dependencies.empty()) dependencies = DependencyGraph();
+    }
+    
+    // Partials live in the calling thread's scratch arena; callers hold an
+    // ArenaScope
+    template<typename Partial, typename ChunkFn>
+    ScratchVector<Partial> reduceChunks(ChunkFn chunkFn) const {
+        const std::size_t n = size();
+        const std::size_t chunks = (n + reductionChunk - 1) / reductionChunk;
+        ScratchVector<Partial> partials(chunks);
+        
+        auto runChunk = [&](std::size_t c) {
+            std::size_t begin = c * reductionChunk;
+            std::size_t end = std::min(n, begin + reductionChunk);
+            partials[c] = chunkFn(begin, end);
+        };
+        
+        if(mode == ExecutionMode::PARALLEL && numa && chunks > 1) {
+            numa->parallelFor(chunks, shardChunks, std::cref(runChunk));
+        } else if(mode == ExecutionMode::PARALLEL && pool && chunks > 1) {
+            pool->parallelFor(chunks, std::cref(runChunk));
+        } else {
+            for(std::size_t c = 0; c < chunks; ++c) {
+                runChunk(c);
+            }
+        }
+        return partials;
+    }
+    
+    template<typename ChunkFn>
+    double reduceSum(ChunkFn chunkFn) const {
+        ArenaScope scratch;
+        double sum = 0.0;
+        for(double partial : reduceChunks<double>(chunkFn)) {
+            sum += partial;
+        }
+        return sum;
+    }
+    
+    double sumMTBF(std::size_t begin, std::size_t end) const {
+        const FleetColumns c = currentColumns();
+        double sum = 0.0;
+        if(c.mtbf) {
+            for(std::size_t i = begin; i < end; ++i) {
+                sum += c.mtbf[i];
+            }
+        } else {
+            for(std::size_t i = begin; i < end; ++i) {
+                sum += 1.0 / c.failureRate[i];
+            }
+        }
+        return sum;
+    }
+    
+    double sumMTTF(std::size_t begin, std::size_t end) const {
+        const FleetColumns c = currentColumns();
+        double sum = 0.0;
+        if(c.mttf) {
+            for(std::size_t i = begin; i < end; ++i) {
+                sum += c.mttf[i];
+            }
+        } else {
+            for(std::size_t i = begin; i < end; ++i) {
+                sum += static_cast<double>(c.kStages[i]) / c.failureRate[i];
+            }
+        }
+        return sum;
+    }
+    
+    // One block of (rate, stage count) pairs for the batch kernels: views
+    // into the columns, or values widened from the hot records when the
+    // view has them
+    struct ModelBlock {
+        const double* rate;
+        const int* k;
+        double rateBuffer[simd::blockSize];
+        int stageBuffer[simd::blockSize];
+        
+        ModelBlock(const FleetColumns& c, std::size_t base, std::size_t m) {
+            if(!c.hot) {
+                rate = c.failureRate + base;
+                k = c.kStages + base;
+                return;
+            }
+            for(std::size_t j = 0; j < m; ++j) {
+                rateBuffer[j] = c.hot[base + j].failureRate;
+                stageBuffer[j] = c.hot[base + j].kStages;
+            }
+            rate = rateBuffer;
+            k = stageBuffer;
+        }
+    };
+    
+    double sumReliability(std::size_t begin, std::size_t end, double timeHorizon) const {
+        const FleetColumns c = currentColumns();
+        double block[simd::blockSize];
+        double sum = 0.0;
+        for(std::size_t base = begin; base < end; base += simd::blockSize) {
+            std::size_t m = std::min(simd::blockSize, end - base);
+            const ModelBlock models(c, base, m);
+            ErlangModel::reliabilityBatch(models.k, models.rate, m, timeHorizon, block);
+            for(std::size_t j = 0; j < m; ++j) {
+                sum += block[j];
+            }
+        }
+        return sum;
+    }
+    
+    // Same over a slot list, gathered into blocks for the batch kernel
+    double sumReliability(const FleetColumns& c, const std::uint32_t* slots, std::size_t m,
+                          double timeHorizon) const {
+        int k[simd::blockSize];
+        double rate[simd::blockSize];
+        double block[simd::blockSize];
+        double sum = 0.0;
+        for(std::size_t base = 0; base < m; base += simd::blockSize) {
+            std::size_t count = std::min(simd::blockSize, m - base);
+            for(std::size_t j = 0; j < count; ++j) {
+                const std::size_t i = slots[base + j];
+                k[j] = c.hot ? c.hot[i].kStages : c.kStages[i];
+                rate[j] = c.hot ? c.hot[i].failureRate : c.failureRate[i];
+            }
+            ErlangModel::reliabilityBatch(k, rate, count, timeHorizon, block);
+            for(std::size_t j = 0; j < count; ++j) {
+                sum += block[j];
+            }
+        }
+        return sum;
+    }
+    
+    template<int K>
+    static double sumFixedReliability(const FleetColumns& c, std::size_t begin, std::size_t end,
+                                      double timeHorizon) {
+        double block[simd::blockSize];
+        double sum = 0.0;
+        for(std::size_t base = begin; base < end; base += simd::blockSize) {
+            std::size_t m = std::min(simd::blockSize, end - base);
+            const ModelBlock models(c, base, m);
+            FixedErlangModel<K>::reliabilityBatch(models.rate, m, timeHorizon, block);
+            for(std::size_t j = 0; j < m; ++j) {
+                sum += block[j];
+            }
+        }
+        return sum;
+    }
+    
+    // Reliability sum over part of one type range. A range whose sensors
+    // all share one stage count skips the stage column and takes the
+    // unrolled kernel; the result is bit-identical either way.
+    double sumTypeReliability(std::size_t t, std::size_t begin, std::size_t end,
+                              double timeHorizon) const {
+        const FleetColumns c = currentColumns();
+        switch(uniformStages(t)) {
+            case 1: return sumFixedReliability<1>(c, begin, end, timeHorizon);
+            case 2: return sumFixedReliability<2>(c, begin, end, timeHorizon);
+            case 3: return sumFixedReliability<3>(c, begin, end, timeHorizon);
+            case 4: return sumFixedReliability<4>(c, begin, end, timeHorizon);
+            case 5: return sumFixedReliability<5>(c, begin, end, timeHorizon);
+            case 6: return sumFixedReliability<6>(c, begin, end, timeHorizon);
+            case 7: return sumFixedReliability<7>(c, begin, end, timeHorizon);
+            case 8: return sumFixedReliability<8>(c, begin, end, timeHorizon);
+            default: return sumReliability(begin, end, timeHorizon);
+        }
+    }
+    
+    // Stage count shared by every sensor of type t, or 0 if they differ
+    int uniformStages(std::size_t t) const {
+        const FleetColumns c = currentColumns();
+        const std::size_t n = c.typeBegin[t + 1] - c.typeBegin[t];
+        const auto& counts = aggregates.byType[t].stageCount;
+        for(int k = 1; k <= maxSpecializedStages; ++k) {
+            if(counts[k] == n && n > 0) return k;
+        }
+        return 0;
+    }
+    
+    // Health buckets of type t, from the live board in concurrent health mode
+    HealthTally typeTally(std::size_t t) const {
+        if(!healthBoard) return aggregates.byType[t].tally;
+        auto snapshot = healthBoard->acquire();
+        const FleetColumns c = currentColumns();
+        HealthTally tally;
+        for(std::size_t i = c.typeBegin[t]; i < c.typeBegin[t + 1]; ++i) {
+            tally.add(snapshot->health[i], +1);
+        }
+        return tally;
+    }
+    
+    std::size_t typeSize(std::size_t t) const {
+        const FleetColumns c = currentColumns();
+        return c.typeBegin[t + 1] - c.typeBegin[t];
+    }
+    
+    QueryPartial queryPartial(const QueryKey& key, const FleetColumns& c, const double* health,
+                              std::uint32_t chunk, const std::uint32_t* slots, std::size_t m) const {
+        QueryPartial p{chunk, static_cast<std::uint32_t>(m), 0.0, HealthTally()};
+        if(key.metric == CachedMetric::RELIABILITY) {
+            p.reliability = sumReliability(c, slots, m, key.horizon);
+        } else {
+            for(std::size_t j = 0; j < m; ++j) {
+                p.tally.add(health[slots[j]], +1);
+            }
+        }
+        return p;
+    }
+    
+    static_assert(reductionChunk % FleetEpochs::granule == 0, "chunks must hold whole granules");
+    
+    static std::size_t querySpan(const QueryKey& key) {
+        return key.regional ? FleetEpochs::granule : reductionChunk;
+    }
+    
+    // Recompute one chunk's share of a query from scratch
+    QueryPartial chunkPartial(const QueryKey& key, const FleetColumns& c, const double* health,
+                              std::uint32_t chunk) const {
+        const std::size_t begin = std::size_t(chunk) * querySpan(key);
+        const std::size_t end = std::min(c.count, begin + querySpan(key));
+        if(!key.regional) {
+            return {chunk, static_cast<std::uint32_t>(end - begin), 
+                    sumReliability(begin, end, key.horizon), HealthTally()};
+        }
+        std::uint32_t slots[FleetEpochs::granule];
+        std::size_t m = 0;
+        for(std::size_t i = begin; i < end; ++i) {
+            if(key.region.contains(c.locX[i], c.locY[i])) slots[m++] = static_cast<std::uint32_t>(i);
+        }
+        return queryPartial(key, c, health, chunk, slots, m);
+    }
+    
+    // Serve a cacheable query. A current entry is returned as is (without
+    // partials); a stale one is patched by recomputing only the chunks
+    // changed since it was cached; otherwise the result is computed and
+    // stored. Per-chunk partials combine in chunk order, so a patched result
+    // equals a fresh one bit for bit.
+    QueryEntry cachedQuery(const QueryKey& key, ApiProbe& probe) const {
+        const bool healthDependent = key.metric != CachedMetric::RELIABILITY;
+        QueryEntry entry;
+        auto isCurrent = [this, healthDependent](std::uint64_t epoch) {
+            return epochs.unchangedSince(epoch, healthDependent);
+        };
+        // Live health values carry no epochs, so those queries neither use
+        // nor fill the cache (an entry from before concurrent mode is stale)
+        const bool cacheable = !(healthDependent && healthBoard);
+        if(cacheable && queryCache.findCurrent(key, isCurrent, entry)) return entry;
+        
+        std::shared_ptr<const HealthSnapshot> pin;
+        const double* health = currentHealth(pin);
+        const FleetColumns c = currentColumns();
+        const std::size_t span = querySpan(key);
+        const std::size_t chunkCount = (c.count + span - 1) / span;
+        const std::uint64_t epoch = epochs.now();
+        std::size_t processed = 0;
+        
+        std::vector<std::uint32_t> dirty;
+        if(cacheable && queryCache.find(key, entry) &&
+           epochs.changedSince(entry.epoch, healthDependent, span, c.count, dirty)) {
+            std::vector<QueryPartial> merged;
+            merged.reserve(entry.partials.size() + dirty.size());
+            auto it = entry.partials.begin();
+            for(std::uint32_t chunk : dirty) {
+                for(; it != entry.partials.end() && it->chunk < chunk; ++it) {
+                    merged.push_back(*it);
+                }
+                if(it != entry.partials.end() && it->chunk == chunk) ++it;
+                QueryPartial p = chunkPartial(key, c, health, chunk);
+                processed += std::min(span, c.count - std::size_t(chunk) * span);
+                if(p.count > 0) merged.push_back(p);
+            }
+            for(; it != entry.partials.end() && it->chunk < chunkCount; ++it) {
+                merged.push_back(*it);
+            }
+            entry.partials = std::move(merged);
+        } else if(!key.regional) {
+            ArenaScope scratch;
+            auto sums = reduceChunks<double>([this, &key](std::size_t b, std::size_t e) {
+                return sumReliability(b, e, key.horizon);
+            });
+            entry.partials.clear();
+            for(std::size_t chunk = 0; chunk < sums.size(); ++chunk) {
+                std::size_t begin = chunk * reductionChunk;
+                std::size_t count = std::min(reductionChunk, c.count - begin);
+                entry.partials.push_back({static_cast<std::uint32_t>(chunk), 
+                                          static_cast<std::uint32_t>(count), sums[chunk], HealthTally()});
+            }
+            processed = c.count;
+        } else {
+            ArenaScope scratch;
+            ScratchVector<std::uint32_t> slots = regionSlots(key.region);
+            std::sort(slots.begin(), slots.end());
+            entry.partials.clear();
+            for(std::size_t first = 0; first < slots.size();) {
+                std::uint32_t chunk = static_cast<std::uint32_t>(slots[first] / span);
+                std::size_t last = first;
+                while(last < slots.size() && slots[last] / span == chunk) ++last;
+                entry.partials.push_back(queryPartial(key, c, health, chunk, 
+                                                      slots.data() + first, last - first));
+                first = last;
+            }
+            processed = slots.size();
+        }
+        
+        entry.key = key;
+        entry.epoch = epoch;
+        entry.combine();
+        probe.setProcessed(processed);
+        if(cacheable) queryCache.store(entry);
+        return entry;
+    }
+    
+    struct SnapshotPartial {
+        double mtbfSum;
+        double mttfSum;
+        double reliabilitySum;
+        SensorStats stats;
+        int cascadeFailures;
+    };
+    
+    // One reduction chunk's sums for each type range it overlaps
+    struct TypeChunkPartial {
+        std::array<double, sensorTypeCount> reliabilitySum;
+        std::array<HealthTally, sensorTypeCount> tally;
+    };
+    
+    // Fused kernel: every per-sensor column is read once per chunk
+    SnapshotPartial snapshotChunk(const FleetColumns& c, std::size_t begin, std::size_t end, 
+                                  double timeHorizon) const {
+        // Live concurrent health is only in c.health
+        const bool hotHealth = c.hot && !healthBoard;
+        
+        SnapshotPartial p = {0.0, 0.0, 0.0, {static_cast<int>(end - begin), 0, 0, 0}, 0};
+        double block[simd::blockSize];
+        
+        for(std::size_t base = begin; base < end; base += simd::blockSize) {
+            std::size_t m = std::min(simd::blockSize, end - base);
+            const ModelBlock models(c, base, m);
+            const double* rate = models.rate;
+            const int* k = models.k;
+            ErlangModel::reliabilityBatch(k, rate, m, timeHorizon, block);
+            
+            for(std::size_t j = 0; j < m; ++j) {
+                const double health = hotHealth ? c.hot[base + j].getHealth() : c.health[base + j];
+                p.mtbfSum += 1.0 / rate[j];
+                p.mttfSum += static_cast<double>(k[j]) / rate[j];
+                p.reliabilitySum += block[j];
+                
+                if(health > 70.0) {
+                    p.stats.active++;
+                } else if(health > 30.0) {
+                    p.stats.warning++;
+                } else {
+                    p.stats.failed++;
+                }
+                p.cascadeFailures += health < 30.0;
+            }
+        }
+        return p;
+    }
+    
+    // Fused snapshot reduction, combined in chunk order
+    FleetSummary summarizeMetrics(double timeHorizon) const {
+        FleetColumns c = currentColumns();
+        std::shared_ptr<const HealthSnapshot> health;
+        if(healthBoard) {
+            health = healthBoard->acquire();
+            c.health = health->health.data();
+        }
+        
+        ArenaScope scratch;
+        auto partials = reduceChunks<SnapshotPartial>(
+            [this, &c, timeHorizon](std::size_t b, std::size_t e) {
+                return snapshotChunk(c, b, e, timeHorizon);
+            });
+        
+        FleetSummary summary;
+        summary.timeHorizon = timeHorizon;
+        summary.count = size();
+        for(const auto& p : partials) {
+            summary.mtbfSum += p.mtbfSum;
+            summary.mttfSum += p.mttfSum;
+            summary.reliabilitySum += p.reliabilitySum;
+            summary.active += p.stats.active;
+            summary.warning += p.stats.warning;
+            summary.failed += p.stats.failed;
+            summary.cascadeFailures += p.cascadeFailures;
+        }
+        return summary;
+    }
+    
+    static CascadeRisk classifyCascade(int currentFailures, std::size_t fleetSize) {
+        CascadeRisk risk;
+        risk.currentFailures = currentFailures;
+        risk.riskFactor = static_cast<double>(currentFailures) / fleetSize;
+        
+        if(risk.riskFactor > 0.2) {
+            risk.dependencyMultiplier = 1.5;
+        } else if(risk.riskFactor > 0.1) {
+            risk.dependencyMultiplier = 1.2;
+        } else {
             risk.dependencyMultiplier = 1.0;
         }
         
-        risk.expectedAdditional = static_cast<int>(
-            risk.currentFailures * risk.dependencyMultiplier * 0.3
-        );
+        risk.expectedAdditional = static_cast<int>(
+            risk.currentFailures * risk.dependencyMultiplier * 0.3
+        );
+        
+        if(risk.riskFactor > 0.15) {
+            risk.riskLevel = RiskLevel::HIGH;
+        } else if(risk.riskFactor > 0.08) {
+            risk.riskLevel = RiskLevel::MEDIUM;
+        } else {
+            risk.riskLevel = RiskLevel::LOW;
+        }
+        
+        return risk;
+    }
+
+public:
+    void reserve(std::size_t n, std::size_t idBytes = 0) {
+        materialize();
+        const std::size_t placedCapacity = store.capacity();
+        store.reserve(n, idBytes);
+        idIndex.reserve(n);
+        if(numa && store.capacity() != placedCapacity) placeShards();
+    }
+    
+    // PARALLEL uses the given pool, or the process-wide shared pool if none
+    void setExecutionMode(ExecutionMode newMode, ThreadPool* threadPool = nullptr) {
+        mode = newMode;
+        pool = (newMode == ExecutionMode::PARALLEL)
+            ? (threadPool ? threadPool : &ThreadPool::shared())
+            : nullptr;
+    }
+    
+    ExecutionMode getExecutionMode() const {
+        return mode;
+    }
+    
+    // Shard the fleet across NUMA nodes: each node's contiguous range of
+    // reduction chunks is re-homed by first touch from that node's pinned
+    // workers, and PARALLEL reductions run every chunk on its owning node.
+    // Partials are still combined in chunk order, so results match SERIAL
+    // bit for bit. nullptr goes back to the flat pool.
+    void setNumaSharding(NumaExecutor* executor = &NumaExecutor::shared()) {
+        numa = executor;
+        shardChunks = 0;
+        placeShards();
+    }
+    
+    NumaExecutor* getNumaSharding() const {
+        return numa;
+    }
+    
+    // Redo first-touch placement, e.g. after a burst of single-sensor adds.
+    // reserve and bulk adds re-place whenever the columns reallocate. Mapped
+    // snapshots keep the page cache's placement.
+    void placeShards() {
+        if(!numa || mapped) return;
+        shardChunks = store.place(reductionChunk, [this](std::size_t count, const auto& body) {
+            numa->parallelFor(count, count, std::cref(body));
+        });
+    }
+    
+    std::size_t addSensor(std::string_view id, SensorType type, const Location& loc,
+                          double health, double uptime, double rate, int k, int qPos) {
+        materialize();
+        if(history) history->resize(size() + 1);
+        std::size_t slot = store.add(id, type, loc, health, uptime, rate, k, qPos,
+            [this](std::size_t from, std::size_t to) { relocateSlot(from, to); });
+        countSensor(slot, +1);
+        epochs.touch(FleetEpochs::STRUCTURE, slot);
+        idIndex.insert(id, slot);
+        if(spatialValid) spatial.insert(slot, loc.x, loc.y);
+        return slot;
+    }
+    
+    std::size_t addSensor(const Sensor& sensor) {
+        return addSensor(sensor.getId(), sensor.getType(), sensor.getLocation(),
+                         sensor.getHealth(), sensor.getUptime(), 
+                         sensor.getFailureRate(), sensor.getKStages(),
+                         sensor.getQueuePosition());
+    }
+    
+    // Bulk insert of a decoded ingest chunk (types below sensorTypeCount);
+    // returns the number of sensors added
+    std::size_t addSensors(const SensorChunk& chunk) {
+        materialize();
+        const std::size_t placedCapacity = store.capacity();
+        if(history) history->resize(size() + chunk.count);
+        store.append(chunk,
+            [this](std::size_t from, std::size_t to) { relocateSlot(from, to); },
+            [this](std::size_t slot) {
+                countSensor(slot, +1);
+                idIndex.insert(store.getId(slot), slot);
+                epochs.touch(FleetEpochs::STRUCTURE, slot);
+                if(spatialValid) {
+                    Location loc = store.getLocation(slot);
+                    spatial.insert(slot, loc.x, loc.y);
+                }
+            });
+        if(numa && store.capacity() != placedCapacity) placeShards();
+        return chunk.count;
+    }
+    
+    void setHealth(std::size_t slot, double health) {
+        if(healthBoard) {
+            healthBoard->publish(slot, health);   // ignores slots out of range
+            return;
+        }
+        materialize();
+        countHealth(store.getType(slot), store.getHealth(slot), -1);
+        store.setHealth(slot, health);
+        countHealth(store.getType(slot), health, +1);
+        epochs.touch(FleetEpochs::HEALTH, slot);
+    }
+    
+    // O(1): the last sensor of the same type moves into this slot, and each
+    // later type range shifts down by one slot (moving one sensor each)
+    void removeSensor(std::size_t slot) {
+        materialize();
+        countSensor(slot, -1);
+        epochs.touch(FleetEpochs::STRUCTURE, slot);
+        idIndex.erase(store.getId(slot), slot);
+        dependencies = DependencyGraph();
+        if(spatialValid) spatial.erase(slot);
+        store.remove(slot, [this](std::size_t from, std::size_t to) { relocateSlot(from, to); });
+        if(spatialValid) spatial.truncate(store.size());
+        if(history) history->resize(store.size());
+    }
+    
+    // Slot of the sensor registered under id, or npos
+    std::size_t findSensor(std::string_view id) const {
+        return idIndex.find(id, currentColumns());
+    }
+    
+    // Returns false if no sensor has this id
+    bool updateHealth(std::string_view id, double health) {
+        std::size_t slot = findSensor(id);
+        if(slot == npos) return false;
+        setHealth(slot, health);
+        return true;
+    }
+    
+    static constexpr std::size_t npos = SensorIdIndex::npos;
+    
+    // Start keeping a compressed health time series per sensor, at the given
+    // value precision (see HealthHistory). Histories follow their sensors
+    // across slot moves; opening a snapshot drops them.
+    void enableHealthHistory(int mantissaBits = 52) {
+        if(!history) history = std::make_unique<HealthHistory>(size(), mantissaBits);
+    }
+    
+    const HealthHistory* healthHistory() const {
+        return history.get();
+    }
+    
+    // setHealth plus a history sample at time (seconds). Returns false if
+    // the sample is older than the slot's latest; health is still updated.
+    bool recordHealth(std::size_t slot, std::int64_t time, double health) {
+        setHealth(slot, health);
+        return !history || history->append(slot, time, health);
+    }
+    
+    // Slots with a health sample below threshold in [from, to], in slot
+    // order. Blocks outside the window or never below the threshold are
+    // skipped on their summaries.
+    std::vector<std::size_t> sensorsBelow(double threshold, std::int64_t from,
+                                          std::int64_t to) const {
+        ApiProbe probe(MetricApi::HEALTH_HISTORY, size());
+        std::vector<std::size_t> result;
+        if(!history) return result;
+        
+        ArenaScope scratch;
+        auto partials = reduceChunks<std::vector<std::size_t>>(
+            [&](std::size_t begin, std::size_t end) {
+                std::vector<std::size_t> hits;
+                for(std::size_t i = begin; i < end; ++i) {
+                    if((*history)[i].droppedBelow(threshold, from, to)) hits.push_back(i);
+                }
+                return hits;
+            });
+        for(const auto& hits : partials) {
+            result.insert(result.end(), hits.begin(), hits.end());
+        }
+        return result;
+    }
+    
+    // Recompute the running sums from a full scan, discarding accumulated
+    // rounding from long add/remove histories
+    void rebuildAggregates() {
+        endConcurrentHealth();
+        aggregates = FleetAggregates();
+        aggregates.mtbfSum.add(reduceSum([this](std::size_t b, std::size_t e) {
+            return sumMTBF(b, e);
+        }));
+        aggregates.mttfSum.add(reduceSum([this](std::size_t b, std::size_t e) {
+            return sumMTTF(b, e);
+        }));
+        const FleetColumns c = currentColumns();
+        for(std::size_t t = 0; t < sensorTypeCount; ++t) {
+            TypeAggregates& typed = aggregates.byType[t];
+            const std::size_t begin = c.typeBegin[t], end = c.typeBegin[t + 1];
+            typed.mtbfSum.add(sumMTBF(begin, end));
+            typed.mttfSum.add(sumMTTF(begin, end));
+            for(std::size_t i = begin; i < end; ++i) {
+                typed.stageCount[stageBucket(c.kStages[i])] += 1;
+                countHealth(static_cast<SensorType>(t), c.health[i], +1);
+            }
+        }
+    }
+    
+    // O(1) from the running aggregates
+    double calculateFleetMTBF() const {
+        return aggregates.mtbfSum.value() / size();
+    }
+    
+    double calculateFleetMTTF() const {
+        return aggregates.mttfSum.value() / size();
+    }
+    
+    // Served from the query cache when the fleet's models are unchanged;
+    // bit-identical to the full reduction either way
+    double calculateFleetReliability(double timeHorizon) const {
+        ApiProbe probe(MetricApi::FLEET_RELIABILITY);
+        return cachedQuery({CachedMetric::RELIABILITY, timeHorizon, false, Region()}, probe).reliability;
+    }
+    
+    // Fleet reliability at several horizons from one pass: every block of
+    // rates and stages is loaded once and evaluated at each horizon not
+    // already cached. Results and cache entries are those of
+    // calculateFleetReliability(h), bit for bit.
+    void calculateFleetReliability(const double* horizons, std::size_t count, double* out) const {
+        ApiProbe probe(MetricApi::FLEET_RELIABILITY);
+        auto isCurrent = [this](std::uint64_t epoch) { return epochs.unchangedSince(epoch, false); };
+        std::vector<double> missing;
+        for(std::size_t i = 0; i < count; ++i) {
+            QueryEntry entry;
+            if(queryCache.findCurrent({CachedMetric::RELIABILITY, horizons[i], false, Region()},
+                                      isCurrent, entry)) {
+                out[i] = entry.reliability;
+            } else if(std::find(missing.begin(), missing.end(), horizons[i]) == missing.end()) {
+                missing.push_back(horizons[i]);
+            }
+        }
+        if(missing.empty()) return;
+        
+        const FleetColumns c = currentColumns();
+        const std::uint64_t epoch = epochs.now();
+        const std::size_t h = missing.size();
+        const std::size_t chunks = (c.count + reductionChunk - 1) / reductionChunk;
+        ArenaScope scratch;
+        double* sums = scratch.get().allocateArray<double>(chunks * h);
+        
+        reduceChunks<char>([&](std::size_t b, std::size_t e) {
+            double* row = sums + (b / reductionChunk) * h;
+            std::fill(row, row + h, 0.0);
+            double block[simd::blockSize];
+            for(std::size_t base = b; base < e; base += simd::blockSize) {
+                std::size_t m = std::min(simd::blockSize, e - base);
+                const ModelBlock models(c, base, m);
+                for(std::size_t j = 0; j < h; ++j) {
+                    ErlangModel::reliabilityBatch(models.k, models.rate, m, missing[j], block);
+                    double sum = row[j];
+                    for(std::size_t i = 0; i < m; ++i) {
+                        sum += block[i];
+                    }
+                    row[j] = sum;
+                }
+            }
+            return char(0);
+        });
+        probe.setProcessed(c.count);
+        
+        for(std::size_t j = 0; j < h; ++j) {
+            QueryEntry entry;
+            entry.key = {CachedMetric::RELIABILITY, missing[j], false, Region()};
+            entry.epoch = epoch;
+            for(std::size_t chunk = 0; chunk < chunks; ++chunk) {
+                std::size_t begin = chunk * reductionChunk;
+                std::size_t size = std::min(reductionChunk, c.count - begin);
+                entry.partials.push_back({static_cast<std::uint32_t>(chunk), 
+                                          static_cast<std::uint32_t>(size), sums[chunk * h + j], 
+                                          HealthTally()});
+            }
+            entry.combine();
+            for(std::size_t i = 0; i < count; ++i) {
+                if(horizons[i] == missing[j]) out[i] = entry.reliability;
+            }
+            queryCache.store(std::move(entry));
+        }
+    }
+    
+    // Evaluates a whole scenario grid in one pass over the fleet. Erlang
+    // reliability depends on rate and time only through their product, so
+    // multiplier m at horizon t is the recorded rates at horizon m t. Each
+    // block of rates and stages is loaded once and evaluated at every
+    // distinct scaled horizon while it sits in L1, and the same pass sums
+    // the fleet failure rate for the queues. Chunk rows run on the pool in
+    // PARALLEL mode and combine in chunk order. At multiplier 1 the results
+    // equal calculateFleetReliability(t) bit for bit. Bypasses the query cache.
+    ScenarioSweep sweepScenarios(const ScenarioGrid& grid) const {
+        ApiProbe probe(MetricApi::SCENARIO_SWEEP, size());
+        ScenarioSweep sweep;
+        sweep.multipliers = grid.rateMultipliers.size();
+        sweep.horizons = grid.horizons.size();
+        sweep.crewSizes = grid.crews.size();
+        
+        // Distinct scaled horizons and each grid point's index among them
+        std::vector<double> scaled;
+        for(double multiplier : grid.rateMultipliers) {
+            for(double horizon : grid.horizons) {
+                scaled.push_back(multiplier * horizon);
+            }
+        }
+        std::vector<std::uint32_t> column(scaled.size());
+        std::vector<double> distinct(scaled);
+        std::sort(distinct.begin(), distinct.end());
+        distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+        for(std::size_t i = 0; i < scaled.size(); ++i) {
+            column[i] = static_cast<std::uint32_t>(
+                std::lower_bound(distinct.begin(), distinct.end(), scaled[i]) - distinct.begin());
+        }
+        
+        // Each chunk row holds its failure-rate sum, then one reliability
+        // sum per distinct horizon
+        const FleetColumns c = currentColumns();
+        const std::size_t h = distinct.size();
+        const std::size_t width = h + 1;
+        const std::size_t chunks = (c.count + reductionChunk - 1) / reductionChunk;
+        ArenaScope scratch;
+        double* sums = scratch.get().allocateArray<double>(chunks * width);
+        
+        reduceChunks<char>([&](std::size_t b, std::size_t e) {
+            double* row = sums + (b / reductionChunk) * width;
+            std::fill(row, row + width, 0.0);
+            double block[simd::blockSize];
+            for(std::size_t base = b; base < e; base += simd::blockSize) {
+                std::size_t m = std::min(simd::blockSize, e - base);
+                const ModelBlock models(c, base, m);
+                double rateSum = row[0];
+                for(std::size_t i = 0; i < m; ++i) {
+                    rateSum += models.rate[i];
+                }
+                row[0] = rateSum;
+                for(std::size_t j = 0; j < h; ++j) {
+                    ErlangModel::reliabilityBatch(models.k, models.rate, m, distinct[j], block);
+                    double sum = row[j + 1];
+                    for(std::size_t i = 0; i < m; ++i) {
+                        sum += block[i];
+                    }
+                    row[j + 1] = sum;
+                }
+            }
+            return char(0);
+        });
+        
+        std::vector<double> totals(width, 0.0);
+        for(std::size_t chunk = 0; chunk < chunks; ++chunk) {
+            for(std::size_t j = 0; j < width; ++j) {
+                totals[j] += sums[chunk * width + j];
+            }
+        }
+        sweep.reliability.resize(scaled.size());
+        for(std::size_t i = 0; i < scaled.size(); ++i) {
+            sweep.reliability[i] = meanReliability(totals[column[i] + 1], c.count);
+        }
+        
+        // One Erlang B recurrence per multiplier serves every crew size
+        const double fleetMTBF = calculateFleetMTBF();
+        const double service = 1.0 / grid.meanRepairTime;
+        int maxCrews = 1;
+        for(int crews : grid.crews) maxCrews = std::max(maxCrews, crews);
+        std::vector<QueueMetrics> byCrews(static_cast<std::size_t>(maxCrews));
+        sweep.queue.reserve(sweep.multipliers * sweep.crewSizes);
+        for(double multiplier : grid.rateMultipliers) {
+            const double arrival = multiplier * totals[0];
+            sweep.mtbf.push_back(fleetMTBF / multiplier);
+            sweep.failureRate.push_back(arrival);
+            if(grid.crews.empty()) continue;
+            QueueingModel::sweepServers(arrival, service, 1, maxCrews, byCrews.data());
+            for(int crews : grid.crews) {
+                sweep.queue.push_back(byCrews[static_cast<std::size_t>(std::max(crews, 1) - 1)]);
+            }
+        }
+        return sweep;
+    }
+    
+    SensorStats getSensorStats() const {
+        if(healthBoard) {
+            return getSensorStats(*healthBoard->acquire());
+        }
+        return {static_cast<int>(size()), aggregates.tally.active, 
+                aggregates.tally.warning, aggregates.tally.failed};
+    }
+    
+    CascadeRisk analyzeCascadeRisk() const {
+        if(healthBoard) {
+            return analyzeCascadeRisk(*healthBoard->acquire());
+        }
+        return classifyCascade(aggregates.tally.cascadeFailures, size());
+    }
+    
+    // Region-scoped queries visit only the sensors inside the region, or
+    // patch a cached result for the same region
+    double calculateFleetReliability(double timeHorizon, const Region& region) const {
+        ApiProbe probe(MetricApi::FLEET_RELIABILITY_REGION);
+        return cachedQuery({CachedMetric::RELIABILITY, timeHorizon, true, region}, probe).reliability;
+    }
+    
+    SensorStats getSensorStats(const Region& region) const {
+        ApiProbe probe(MetricApi::SENSOR_STATS_REGION);
+        QueryEntry r = cachedQuery({CachedMetric::SENSOR_STATS, 0.0, true, region}, probe);
+        return {static_cast<int>(r.count), r.tally.active, r.tally.warning, r.tally.failed};
+    }
+    
+    CascadeRisk analyzeCascadeRisk(const Region& region) const {
+        ApiProbe probe(MetricApi::CASCADE_RISK_REGION);
+        QueryEntry r = cachedQuery({CachedMetric::CASCADE_RISK, 0.0, true, region}, probe);
+        return classifyCascade(r.tally.cascadeFailures, r.count);
+    }
+    
+    // Per-type queries. Each type is one contiguous slot range with its own
+    // running aggregates, so means and counts are O(1) and reliability is a
+    // scan of that range alone.
+    double calculateFleetMTBF(SensorType type) const {
+        const std::size_t t = static_cast<std::size_t>(type);
+        return aggregates.byType[t].mtbfSum.value() / typeSize(t);
+    }
+    
+    double calculateFleetMTTF(SensorType type) const {
+        const std::size_t t = static_cast<std::size_t>(type);
+        return aggregates.byType[t].mttfSum.value() / typeSize(t);
+    }
+    
+    double calculateFleetReliability(double timeHorizon, SensorType type) const {
+        const std::size_t t = static_cast<std::size_t>(type);
+        const FleetColumns c = currentColumns();
+        ApiProbe probe(MetricApi::FLEET_RELIABILITY_TYPE, typeSize(t));
+        // Split at the reduction chunk boundaries like computeTypeSnapshots,
+        // so the two agree exactly
+        double sum = 0.0;
+        for(std::size_t begin = c.typeBegin[t]; begin < c.typeBegin[t + 1];) {
+            std::size_t end = std::min(c.typeBegin[t + 1], (begin / reductionChunk + 1) * reductionChunk);
+            sum += sumTypeReliability(t, begin, end, timeHorizon);
+            begin = end;
+        }
+        return meanReliability(sum, typeSize(t));
+    }
+    
+    SensorStats getSensorStats(SensorType type) const {
+        const std::size_t t = static_cast<std::size_t>(type);
+        HealthTally tally = typeTally(t);
+        return {static_cast<int>(typeSize(t)), tally.active, tally.warning, tally.failed};
+    }
+    
+    CascadeRisk analyzeCascadeRisk(SensorType type) const {
+        const std::size_t t = static_cast<std::size_t>(type);
+        return classifyCascade(typeTally(t).cascadeFailures, typeSize(t));
+    }
+    
+    // Most common stage count among sensors of the type (0 if none is in
+    // 1..maxSpecializedStages)
+    int typicalStages(SensorType type) const {
+        const auto& counts = aggregates.byType[static_cast<std::size_t>(type)].stageCount;
+        int best = 0;
+        for(int k = 1; k <= maxSpecializedStages; ++k) {
+            if(counts[k] > 0 && (best == 0 || counts[k] > counts[best])) best = k;
+        }
+        return best;
+    }
+    
+    // Slot range [first, second) holding the sensors of a type
+    std::pair<std::size_t, std::size_t> typeRange(SensorType type) const {
+        const FleetColumns c = currentColumns();
+        return {c.typeBeginOf(type), c.typeEndOf(type)};
+    }
+    
+    // Every type's metrics from one reduceChunks pass over the fleet: each
+    // chunk sums the pieces of the type ranges it overlaps, and the pieces
+    // combine per type in chunk order. Means come from the running per-type
+    // aggregates. Health buckets do too, except in concurrent health mode,
+    // where one pinned epoch is tallied in the same pass.
+    std::array<FleetSnapshot, sensorTypeCount> computeTypeSnapshots(double timeHorizon) const {
+        ApiProbe probe(MetricApi::FLEET_TYPE_SNAPSHOTS, size());
+        const FleetColumns c = currentColumns();
+        std::shared_ptr<const HealthSnapshot> health;
+        if(healthBoard) health = healthBoard->acquire();
+        
+        ArenaScope scratch;
+        auto partials = reduceChunks<TypeChunkPartial>([&](std::size_t b, std::size_t e) {
+            TypeChunkPartial p{};
+            for(std::size_t t = 0; t < sensorTypeCount; ++t) {
+                std::size_t begin = std::max(b, c.typeBegin[t]);
+                std::size_t end = std::min(e, c.typeBegin[t + 1]);
+                if(begin >= end) continue;
+                p.reliabilitySum[t] = sumTypeReliability(t, begin, end, timeHorizon);
+                if(health) {
+                    for(std::size_t i = begin; i < end; ++i) {
+                        p.tally[t].add(health->health[i], +1);
+                    }
+                }
+            }
+            return p;
+        });
+        
+        std::array<FleetSnapshot, sensorTypeCount> result;
+        for(std::size_t t = 0; t < sensorTypeCount; ++t) {
+            const double n = static_cast<double>(typeSize(t));
+            double reliabilitySum = 0.0;
+            HealthTally tally = health ? HealthTally() : aggregates.byType[t].tally;
+            for(const TypeChunkPartial& p : partials) {
+                reliabilitySum += p.reliabilitySum[t];
+                if(health) {
+                    tally.active += p.tally[t].active;
+                    tally.warning += p.tally[t].warning;
+                    tally.failed += p.tally[t].failed;
+                    tally.cascadeFailures += p.tally[t].cascadeFailures;
+                }
+            }
+            FleetSnapshot& snapshot = result[t];
+            snapshot.timeHorizon = timeHorizon;
+            snapshot.mtbf = aggregates.byType[t].mtbfSum.value() / n;
+            snapshot.mttf = aggregates.byType[t].mttfSum.value() / n;
+            snapshot.reliability = meanReliability(reliabilitySum, typeSize(t));
+            snapshot.stats = {static_cast<int>(typeSize(t)), tally.active, tally.warning, tally.failed};
+            snapshot.cascade = classifyCascade(tally.cascadeFailures, typeSize(t));
+        }
+        return result;
+    }
+    
+    // Entries kept by the query cache; 0 disables it
+    void setQueryCacheCapacity(std::size_t entries) {
+        queryCache.setCapacity(entries);
+    }
+    
+    std::size_t getQueryCacheCapacity() const {
+        return queryCache.getCapacity();
+    }
+    
+    // Install the sensor dependency topology. The graph is slot-indexed:
+    // sensors added later are isolated nodes, and any mutation that moves
+    // sensors between slots (removeSensor always; an add whenever a later
+    // type range is non-empty) clears it. Returns false, keeping the
+    // current graph, when the graph has more nodes than the fleet.
+    bool setDependencyGraph(DependencyGraph graph) {
+        if(graph.nodes() > size()) return false;
+        dependencies = std::move(graph);
+        return true;
+    }
+    
+    const DependencyGraph& getDependencyGraph() const {
+        return dependencies;
+    }
+    
+    // Connect every pair of sensors closer than radius, with propagation
+    // probability falling linearly from maxWeight at distance 0 to 0
+    DependencyGraph buildProximityGraph(double radius, double maxWeight) const {
+        const FleetColumns c = currentColumns();
+        const SpatialGrid& grid = spatialIndex();
+        ArenaScope scratch;
+        ScratchVector<DependencyGraph::Edge> edges;
+        
+        for(std::size_t u = 0; u < c.count; ++u) {
+            grid.forEach(Region::circle(c.locX[u], c.locY[u], radius), c, 
+                         [&](std::uint32_t v) {
+                if(v == u) return;
+                double dx = c.locX[v] - c.locX[u], dy = c.locY[v] - c.locY[u];
+                double d = std::sqrt(dx * dx + dy * dy);
+                edges.push_back({static_cast<std::uint32_t>(u), v, 
+                                 maxWeight * (1.0 - d / radius)});
+            });
+        }
+        return DependencyGraph::fromEdges(c.count, edges.data(), edges.size());
+    }
+    
+    // Simulate failure spread from the currently failed sensors (health < 30)
+    // over the dependency graph; returns per-sensor failure probabilities
+    CascadePropagation propagateCascade(int maxDepth = 32, double epsilon = 1e-6) const {
+        ApiProbe probe(MetricApi::CASCADE_PROPAGATION, size());
+        std::shared_ptr<const HealthSnapshot> pin;
+        const double* health = currentHealth(pin);
+        return propagateFailures(dependencies, health, size(),
+                                 mode == ExecutionMode::PARALLEL ? pool : nullptr,
+                                 maxDepth, epsilon);
+    }
+    
+    // Monte Carlo fleet-lifetime simulation from the current fleet state;
+    // reproducible for a given seed in either execution mode
+    MonteCarloResult simulateLifetimes(const MonteCarloConfig& config) const {
+        std::shared_ptr<const HealthSnapshot> pin;
+        const double* health = currentHealth(pin);
+        return simulateFleetLifetimes(currentColumns(), health, config,
+                                      mode == ExecutionMode::PARALLEL ? pool : nullptr);
+    }
+    
+    // Maximum-likelihood lifetime fits, on the pool in PARALLEL mode. A single
+    // Weibull fits failures of the given mode; the competing-risk fit takes
+    // every mode present in the sample.
+    WeibullFit fitWeibull(const LifetimeSample& sample, int failureMode = 1) const {
+        if(failureMode < 1 || failureMode > maxFailureModes) return WeibullFit();
+        return fitWeibullModes(sample, failureMode, 1,
+                               mode == ExecutionMode::PARALLEL ? pool : nullptr)[0];
+    }
+    
+    CompetingRiskFit fitCompetingRisks(const LifetimeSample& sample) const {
+        CompetingRiskFit result;
+        result.modes = fitWeibullModes(sample, 1, sample.modes(),
+                                       mode == ExecutionMode::PARALLEL ? pool : nullptr);
+        std::vector<WeibullModel> components;
+        for(const WeibullFit& fit : result.modes) {
+            components.push_back(fit.model);
+            result.logLikelihood += fit.logLikelihood;
+        }
+        result.model = CompetingRiskModel(std::move(components));
+        return result;
+    }
+    
+    // Discrete-event simulation of the maintenance queue fed by the fleet's
+    // per-sensor failure rates
+    MaintenanceSimResult simulateMaintenance(const MaintenanceSimConfig& config) const {
+        std::shared_ptr<const HealthSnapshot> pin;
+        const double* health = currentHealth(pin);
+        return simulateMaintenanceQueue(currentColumns(), health, config);
+    }
+    
+    // Queries against one pinned health epoch, so several metrics can be
+    // read consistently while writers keep publishing
+    SensorStats getSensorStats(const HealthSnapshot& health) const {
+        return {static_cast<int>(health.health.size()), health.tally.active,
+                health.tally.warning, health.tally.failed};
+    }
+    
+    CascadeRisk analyzeCascadeRisk(const HealthSnapshot& health) const {
+        return classifyCascade(health.tally.cascadeFailures, health.health.size());
+    }
+    
+    // Concurrent health mode: publishHealth may then be called from any
+    // number of ingest threads while readers query. The fleet structure is
+    // frozen meanwhile; any other mutation ends the mode first, and the
+    // caller must have stopped publishers by then.
+    void beginConcurrentHealth() {
+        if(healthBoard) return;
+        materialize();
+        healthBoard = std::make_unique<ConcurrentHealthBoard>(
+            store.healthData(), store.size(), aggregates.tally);
+    }
+    
+    // Fold the latest published health values back into the store
+    void endConcurrentHealth() {
+        if(!healthBoard) return;
+        auto last = healthBoard->acquire();
+        healthBoard.reset();
+        epochs.touchAll(FleetEpochs::HEALTH);
+        for(std::size_t i = 0; i < last->health.size(); ++i) {
+            store.setHealth(i, last->health[i]);
+        }
+        aggregates.tally = last->tally;
+        for(std::size_t t = 0; t < sensorTypeCount; ++t) {
+            HealthTally& tally = aggregates.byType[t].tally;
+            tally = HealthTally();
+            for(std::size_t i = store.typeBeginOf(static_cast<SensorType>(t)); 
+                i < store.typeEndOf(static_cast<SensorType>(t)); ++i) {
+                tally.add(last->health[i], +1);
+            }
+        }
+    }
+    
+    bool isConcurrentHealth() const {
+        return static_cast<bool>(healthBoard);
+    }
+    
+    // Lock-free; only valid in concurrent health mode. Returns false if
+    // slot is out of range.
+    bool publishHealth(std::size_t slot, double health) const {
+        return healthBoard->publish(slot, health);
+    }
+    
+    bool publishHealth(std::string_view id, double health) const {
+        std::size_t slot = findSensor(id);
+        if(slot == npos) return false;
+        healthBoard->publish(slot, health);
+        return true;
+    }
+    
+    std::shared_ptr<const HealthSnapshot> acquireHealthSnapshot() const {
+        return healthBoard ? healthBoard->acquire() : nullptr;
+    }
+    
+    // Fleet-mean R(t0 + i * dt) for i in [0, n) into out. Each chunk sums
+    // its sensors' curves into its own row of one scratch matrix; rows
+    // combine in order.
+    void calculateFleetReliabilityCurve(double t0, double dt, std::size_t n, 
+                                        double* out) const {
+        ApiProbe probe(MetricApi::FLEET_RELIABILITY_CURVE, size());
+        ArenaScope scratch;
+        const std::size_t chunks = (size() + reductionChunk - 1) / reductionChunk;
+        double* rows = scratch.get().allocateArray<double>(chunks * n);
+        
+        reduceChunks<char>([this, t0, dt, n, rows](std::size_t b, std::size_t e) {
+            const FleetColumns c = currentColumns();
+            double* partial = rows + (b / reductionChunk) * n;
+            std::fill(partial, partial + n, 0.0);
+            
+            ArenaScope local;
+            double* curve = local.get().allocateArray<double>(n);
+            for(std::size_t i = b; i < e; ++i) {
+                if(c.hot) {
+                    erlangCurve(c.hot[i].kStages, c.hot[i].failureRate, t0, dt, n, curve);
+                } else {
+                    erlangCurve(c.kStages[i], c.failureRate[i], t0, dt, n, curve);
+                }
+                for(std::size_t j = 0; j < n; ++j) {
+                    partial[j] += curve[j];
+                }
+            }
+            return char(0);
+        });
+        
+        std::fill(out, out + n, 0.0);
+        for(std::size_t r = 0; r < chunks; ++r) {
+            const double* partial = rows + r * n;
+            for(std::size_t j = 0; j < n; ++j) {
+                out[j] += partial[j];
+            }
+        }
+        // An empty fleet has nothing that can fail (see meanReliability)
+        const double inverseSize = size() > 0 ? 1.0 / size() : 0.0;
+        for(std::size_t j = 0; j < n; ++j) {
+            out[j] = size() > 0 ? out[j] * inverseSize : 1.0;
+        }
+    }
+    
+    // The k sensors most likely to fail within the horizon, worst first
+    // (ties by slot). One batch Erlang pass per chunk feeds a bounded heap of
+    // the chunk's k lowest reliabilities; the chunk heaps merge in chunk
+    // order and only the final k entries are sorted.
+    std::vector<AtRiskSensor> topKAtRisk(std::size_t k, double timeHorizon) const {
+        ApiProbe probe(MetricApi::TOP_K_AT_RISK, size());
+        struct Candidate {
+            double reliability;
+            std::size_t slot;
+            bool operator<(const Candidate& o) const {
+                return reliability < o.reliability || 
+                       (reliability == o.reliability && slot < o.slot);
+            }
+        };
+        // Max-heap on (reliability, slot): front is the safest kept sensor
+        auto offer = [k](std::vector<Candidate>& heap, const Candidate& c) {
+            if(heap.size() < k) {
+                heap.push_back(c);
+                std::push_heap(heap.begin(), heap.end());
+            } else if(c < heap.front()) {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.back() = c;
+                std::push_heap(heap.begin(), heap.end());
+            }
+        };
+        
+        std::vector<AtRiskSensor> result;
+        if(k == 0 || size() == 0) return result;
+        const FleetColumns c = currentColumns();
+        
+        ArenaScope scratch;
+        auto partials = reduceChunks<std::vector<Candidate>>(
+            [&](std::size_t begin, std::size_t end) {
+                std::vector<Candidate> heap;
+                heap.reserve(std::min(k, end - begin));
+                double block[simd::blockSize];
+                for(std::size_t base = begin; base < end; base += simd::blockSize) {
+                    std::size_t m = std::min(simd::blockSize, end - base);
+                    const ModelBlock models(c, base, m);
+                    ErlangModel::reliabilityBatch(models.k, models.rate, m, timeHorizon, block);
+                    // Most sensors fail the bound check against the current
+                    // safest entry and never touch the heap
+                    for(std::size_t j = 0; j < m; ++j) {
+                        if(heap.size() == k && block[j] > heap.front().reliability) continue;
+                        offer(heap, {block[j], base + j});
+                    }
+                }
+                return heap;
+            });
+        
+        std::vector<Candidate> merged;
+        merged.reserve(std::min(k, size()));
+        for(const auto& heap : partials) {
+            for(const Candidate& candidate : heap) offer(merged, candidate);
+        }
+        std::sort(merged.begin(), merged.end());
+        result.reserve(merged.size());
+        for(const Candidate& candidate : merged) {
+            result.push_back({candidate.slot, 1.0 - candidate.reliability});
+        }
+        return result;
+    }
+    
+    // Single fused full-fleet scan; the O(1) mean queries come from running
+    // sums and may differ from it in the last bits
+    FleetSnapshot computeSnapshot(double timeHorizon) const {
+        ApiProbe probe(MetricApi::FLEET_SNAPSHOT, size());
+        return snapshotFromSummary(summarizeMetrics(timeHorizon));
+    }
+    
+    // Mergeable form of computeSnapshot(timeHorizon) plus the fleet's k
+    // worst sensors, tagged with this shard's number, for one message per
+    // shard in a partitioned deployment
+    FleetSummary summarize(double timeHorizon, std::size_t k = 0, std::uint32_t shard = 0) const {
+        ApiProbe probe(MetricApi::FLEET_SUMMARY, size());
+        FleetSummary summary = summarizeMetrics(timeHorizon);
+        summary.topK = static_cast<std::uint32_t>(k);
+        if(k > 0) {
+            const FleetColumns c = currentColumns();
+            for(const auto& worst : topKAtRisk(k, timeHorizon)) {
+                summary.atRisk.push_back({shard, worst.slot, worst.failureProbability,
+                                          std::string(c.getId(worst.slot))});
+            }
+        }
+        return summary;
+    }
+    
+    static FleetSnapshot snapshotFromSummary(const FleetSummary& summary) {
+        const double n = static_cast<double>(summary.count);
+        FleetSnapshot snapshot;
+        snapshot.timeHorizon = summary.timeHorizon;
+        snapshot.mtbf = summary.mtbfSum / n;
+        snapshot.mttf = summary.mttfSum / n;
+        snapshot.reliability = meanReliability(summary.reliabilitySum, summary.count);
+        snapshot.stats = {static_cast<int>(summary.count), static_cast<int>(summary.active),
+                          static_cast<int>(summary.warning), static_cast<int>(summary.failed)};
+        snapshot.cascade = classifyCascade(static_cast<int>(summary.cascadeFailures),
+                                           static_cast<std::size_t>(summary.count));
+        return snapshot;
+    }
+    
+    // Write a mappable snapshot of the fleet, its precomputed model
+    // parameters and running aggregates
+    bool saveSnapshot(const std::string& path) const {
+        const FleetColumns c = currentColumns();
+        const std::size_t n = c.count;
+        
+        std::vector<double> mtbf(n), mttf(n);
+        std::vector<std::uint32_t> idStart(n), idLength(n);
+        std::vector<char> idPool;
+        for(std::size_t i = 0; i < n; ++i) {
+            mtbf[i] = c.mtbf ? c.mtbf[i] : 1.0 / c.failureRate[i];
+            mttf[i] = c.mttf ? c.mttf[i] : static_cast<double>(c.kStages[i]) / c.failureRate[i];
+            std::string_view id = c.getId(i);
+            idStart[i] = static_cast<std::uint32_t>(idPool.size());
+            idLength[i] = static_cast<std::uint32_t>(id.size());
+            idPool.insert(idPool.end(), id.begin(), id.end());
+        }
+        
+        // The live index may be sparse after removals; write a fresh one
+        SensorIdIndex index;
+        index.rebuild(c);
+        
+        const void* data[SNAP_COLUMN_COUNT] = {
+            c.health, c.failureRate, c.kStages, c.uptimeHours, c.types,
+            c.locX, c.locY, c.locZ, c.queuePositions,
+            mtbf.data(), mttf.data(), idStart.data(), idLength.data(), idPool.data(),
+            index.buckets()
+        };
+        const std::size_t bytes[SNAP_COLUMN_COUNT] = {
+            n * sizeof(double), n * sizeof(double), n * sizeof(int), n * sizeof(double),
+            n * sizeof(SensorType), n * sizeof(double), n * sizeof(double), 
+            n * sizeof(double), n * sizeof(int), n * sizeof(double), n * sizeof(double),
+            n * sizeof(std::uint32_t), n * sizeof(std::uint32_t), idPool.size(),
+            index.bucketCount() * sizeof(IdIndexBucket)
+        };
+        
+        FleetSnapshotHeader header{};
+        std::memcpy(header.magic, fleetSnapshotMagic, sizeof(header.magic));
+        header.version = fleetSnapshotVersion;
+        header.byteOrder = fleetSnapshotByteOrder;
+        header.count = n;
+        header.idPoolBytes = idPool.size();
+        header.idIndexBuckets = index.bucketCount();
+        header.mtbfSum = aggregates.mtbfSum.value();
+        header.mttfSum = aggregates.mttfSum.value();
+        header.active = aggregates.tally.active;
+        header.warning = aggregates.tally.warning;
+        header.failed = aggregates.tally.failed;
+        header.cascadeFailures = aggregates.tally.cascadeFailures;
+        for(std::size_t t = 0; t < sensorTypeCount; ++t) {
+            const TypeAggregates& typed = aggregates.byType[t];
+            SnapshotTypePartition& p = header.partitions[t];
+            p.begin = c.typeBegin[t];
+            p.end = c.typeBegin[t + 1];
+            p.mtbfSum = typed.mtbfSum.value();
+            p.mttfSum = typed.mttfSum.value();
+            p.active = typed.tally.active;
+            p.warning = typed.tally.warning;
+            p.failed = typed.tally.failed;
+            p.cascadeFailures = typed.tally.cascadeFailures;
+            for(int k = 0; k <= maxSpecializedStages; ++k) {
+                p.stageCount[k] = typed.stageCount[k];
+            }
+        }
+        
+        std::uint64_t offset = sizeof(FleetSnapshotHeader);
+        for(int col = 0; col < SNAP_COLUMN_COUNT; ++col) {
+            offset = (offset + 63) / 64 * 64;
+            header.columnOffset[col] = offset;
+            offset += bytes[col];
+        }
+        
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if(!out) return false;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        
+        std::uint64_t written = sizeof(FleetSnapshotHeader);
+        const char padding[64] = {};
+        for(int col = 0; col < SNAP_COLUMN_COUNT; ++col) {
+            out.write(padding, header.columnOffset[col] - written);
+            out.write(static_cast<const char*>(data[col]), bytes[col]);
+            written = header.columnOffset[col] + bytes[col];
+        }
+        return static_cast<bool>(out);
+    }
+    
+    // Serve queries straight from a mapped snapshot, replacing the current
+    // fleet; O(1) apart from header validation
+    bool openSnapshot(const std::string& path) {
+        auto snap = MappedFleetSnapshot::open(path);
+        if(!snap) return false;
+        
+        const FleetSnapshotHeader& h = snap->getHeader();
+        healthBoard.reset();
+        history.reset();
+        spatialValid = false;
+        dependencies = DependencyGraph();
+        epochs.touchAll(FleetEpochs::STRUCTURE);
+        epochs.touchAll(FleetEpochs::HEALTH);
+        store = FleetStore();
+        aggregates = FleetAggregates();
+        aggregates.mtbfSum.add(h.mtbfSum);
+        aggregates.mttfSum.add(h.mttfSum);
+        aggregates.tally.active = static_cast<int>(h.active);
+        aggregates.tally.warning = static_cast<int>(h.warning);
+        aggregates.tally.failed = static_cast<int>(h.failed);
+        aggregates.tally.cascadeFailures = static_cast<int>(h.cascadeFailures);
+        for(std::size_t t = 0; t < sensorTypeCount; ++t) {
+            const SnapshotTypePartition& p = h.partitions[t];
+            TypeAggregates& typed = aggregates.byType[t];
+            typed.mtbfSum.add(p.mtbfSum);
+            typed.mttfSum.add(p.mttfSum);
+            typed.tally.active = static_cast<int>(p.active);
+            typed.tally.warning = static_cast<int>(p.warning);
+            typed.tally.failed = static_cast<int>(p.failed);
+            typed.tally.cascadeFailures = static_cast<int>(p.cascadeFailures);
+            for(int k = 0; k <= maxSpecializedStages; ++k) {
+                typed.stageCount[k] = static_cast<std::size_t>(p.stageCount[k]);
+            }
+        }
+        idIndex.attach(snap->idIndex(), h.idIndexBuckets, h.count);
+        mapped = std::move(snap);
+        return true;
+    }
+    
+    bool isMapped() const {
+        return static_cast<bool>(mapped);
+    }
+    
+    // Resident fleet footprint: columns, ID pool and index, or the mapping
+    std::size_t memoryBytes() const {
+        if(mapped) return mapped->mappedBytes();
+        return store.memoryBytes() + idIndex.memoryBytes();
+    }
+    
+    std::size_t size() const {
+        return mapped ? mapped->columns().count : store.size();
+    }
+    
+    Sensor getSensor(std::size_t i) const {
+        return currentColumns().getSensor(i);
+    }
+    
+    FleetColumns columns() const {
+        return currentColumns();
+    }
+};
+
+// Asynchronous query front end for concurrent callers such as the HTTP
+// layer. Requests queue while the worker thread is busy; each worker pass
+// drains the queue, answers identical requests once and evaluates every
+// distinct fleet-reliability horizon in a single fused scan. The service
+// only reads the manager, so concurrent writers follow the usual rules
+// (health updates through concurrent health mode).
+struct QueryServiceStats {
+    std::uint64_t submitted;
+    std::uint64_t computed;    // distinct results actually evaluated
+    std::uint64_t batches;     // worker passes
+};
+
+class QueryService {
+public:
+    using SensorStats = FleetReliabilityManager::SensorStats;
+    using FleetSnapshot = FleetReliabilityManager::FleetSnapshot;
+
+private:
+    template<typename Value>
+    struct Pending {
+        QueryKey key;
+        std::promise<Value> promise;
+    };
+    
+    struct Queue {
+        std::vector<Pending<double>> reliability;
+        std::vector<Pending<FleetSnapshot>> snapshots;
+        std::vector<Pending<double>> regionReliability;
+        std::vector<Pending<SensorStats>> regionStats;
+        
+        bool empty() const {
+            return reliability.empty() && snapshots.empty() && 
+                   regionReliability.empty() && regionStats.empty();
+        }
+    };
+    
+    const FleetReliabilityManager& manager;
+    std::mutex mutex;
+    std::condition_variable wake;
+    Queue queue;
+    bool stopping = false;
+    std::atomic<std::uint64_t> submitted{0};
+    std::atomic<std::uint64_t> computed{0};
+    std::atomic<std::uint64_t> batches{0};
+    std::thread worker;
+    
+    template<typename Value>
+    std::future<Value> enqueue(std::vector<Pending<Value>> Queue::*list, const QueryKey& key) {
+        Pending<Value> request{key, std::promise<Value>()};
+        std::future<Value> result = request.promise.get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            (queue.*list).push_back(std::move(request));
+        }
+        submitted.fetch_add(1, std::memory_order_relaxed);
+        wake.notify_one();
+        return result;
+    }
+    
+    template<typename Value>
+    struct Outcome {
+        QueryKey key;
+        Value value;
+        std::exception_ptr error;   // set if the evaluation threw
+    };
+    
+    // Evaluate each distinct key once, in arrival order, and fan the value
+    // (or the exception it threw) out to every request with that key. If
+    // the bookkeeping itself fails, the remaining requests get that error.
+    template<typename Value, typename Fn>
+    void answer(std::vector<Pending<Value>>& requests, Fn&& evaluate) {
+        std::vector<Outcome<Value>> done;
+        std::size_t answered = 0;
+        try {
+            for(Pending<Value>& request : requests) {
+                auto it = std::find_if(done.begin(), done.end(), 
+                                       [&](const auto& d) { return d.key == request.key; });
+                if(it == done.end()) {
+                    Outcome<Value> outcome{request.key, Value(), nullptr};
+                    try {
+                        outcome.value = evaluate(request.key);
+                    } catch(...) {
+                        outcome.error = std::current_exception();
+                    }
+                    done.push_back(std::move(outcome));
+                    it = done.end() - 1;
+                }
+                if(it->error) {
+                    request.promise.set_exception(it->error);
+                } else {
+                    request.promise.set_value(it->value);
+                }
+                ++answered;
+            }
+        } catch(...) {
+            for(std::size_t i = answered; i < requests.size(); ++i) {
+                requests[i].promise.set_exception(std::current_exception());
+            }
+        }
+        computed.fetch_add(done.size(), std::memory_order_relaxed);
+    }
+    
+    void process(Queue& batch) {
+        if(!batch.reliability.empty()) {
+            // A failed fused pass fails every reliability request with its exception
+            std::vector<double> horizons, values;
+            std::exception_ptr failure;
+            try {
+                for(const auto& request : batch.reliability) {
+                    double h = request.key.horizon;
+                    if(std::find(horizons.begin(), horizons.end(), h) == horizons.end()) {
+                        horizons.push_back(h);
+                    }
+                }
+                values.resize(horizons.size());
+                manager.calculateFleetReliability(horizons.data(), horizons.size(), values.data());
+            } catch(...) {
+                failure = std::current_exception();
+            }
+            answer(batch.reliability, [&](const QueryKey& key) {
+                if(failure) std::rethrow_exception(failure);
+                return values[std::find(horizons.begin(), horizons.end(), key.horizon) - 
+                              horizons.begin()];
+            });
+        }
+        answer(batch.snapshots, [this](const QueryKey& key) {
+            return manager.computeSnapshot(key.horizon);
+        });
+        answer(batch.regionReliability, [this](const QueryKey& key) {
+            return manager.calculateFleetReliability(key.horizon, key.region);
+        });
+        answer(batch.regionStats, [this](const QueryKey& key) {
+            return manager.getSensorStats(key.region);
+        });
+    }
+    
+    void run() {
+        for(;;) {
+            Queue batch;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this] { return stopping || !queue.empty(); });
+                if(queue.empty()) return;
+                std::swap(batch, queue);
+            }
+            batches.fetch_add(1, std::memory_order_relaxed);
+            process(batch);
+        }
+    }
+
+public:
+    explicit QueryService(const FleetReliabilityManager& fleet) : manager(fleet) {
+        worker = std::thread([this] { run(); });
+    }
+    
+    // Answers everything already submitted, then stops the worker
+    ~QueryService() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+    
+    QueryService(const QueryService&) = delete;
+    QueryService& operator=(const QueryService&) = delete;
+    
+    // Safe from any number of threads
+    std::future<double> fleetReliability(double timeHorizon) {
+        return enqueue(&Queue::reliability, {CachedMetric::RELIABILITY, timeHorizon, false, Region()});
+    }
+    
+    std::future<FleetSnapshot> snapshot(double timeHorizon) {
+        return enqueue(&Queue::snapshots, {CachedMetric::RELIABILITY, timeHorizon, false, Region()});
+    }
+    
+    std::future<double> fleetReliability(double timeHorizon, const Region& region) {
+        return enqueue(&Queue::regionReliability, {CachedMetric::RELIABILITY, timeHorizon, true, region});
+    }
+    
+    std::future<SensorStats> sensorStats(const Region& region) {
+        return enqueue(&Queue::regionStats, {CachedMetric::SENSOR_STATS, 0.0, true, region});
+    }
+    
+    QueryServiceStats stats() const {
+        return {submitted.load(std::memory_order_relaxed), 
+                computed.load(std::memory_order_relaxed),
+                batches.load(std::memory_order_relaxed)};
+    }
+};
+
+// Initialize sample sensor network
+void initializeSensorNetwork(FleetReliabilityManager& manager) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_real_distribution<> locDist(5.0, 95.0);
+    std::uniform_real_distribution<> healthDist(20.0, 100.0);
+    std::uniform_real_distribution<> rateDist(0.0003, 0.0008);
+    std::uniform_int_distribution<> kDist(2, 5);
+    std::uniform_int_distribution<> queueDist(0, 9);
+    
+    std::vector<SensorType> types = {
+        SensorType::TRAFFIC, 
+        SensorType::AIR_QUALITY, 
+        SensorType::WATER_FLOW
+    };
+    
+    manager.reserve(50);
+    for(int i = 0; i < 50; ++i) {
+        std::string id = "SNS-" + std::string(4 - std::to_string(i+1).length(), '0') + 
+                        std::to_string(i+1);
+        
+        Location loc(locDist(gen), locDist(gen), locDist(gen) / 30.0);
+        
+        double health = healthDist(gen);
+        double rate = rateDist(gen);
+        int k = kDist(gen);
+        int qPos = queueDist(gen);
+        
+        manager.addSensor(id, types[i % 3], loc, health, 1000.0 + i * 100.0,
+                          rate, k, qPos);
+    }
+}
+
+// Binary columnar fleet format (little-endian):
+//   header: "IOTS" magic, uint32 version, uint64 record count (0 if unknown)
+//   chunks: uint32 count (0 terminates), uint32 id bytes, then per column
+//           health, uptime, rate, x, y, z as f64[count]; k and type as
+//           u8[count]; queue position as u16[count]; id lengths u8[count];
+//           id bytes
+constexpr char fleetBinaryMagic[4] = {'I', 'O', 'T', 'S'};
+constexpr std::uint32_t fleetBinaryVersion = 1;
+constexpr std::size_t fleetBinaryChunk = 65536;
+
+struct IngestStatus {
+    bool ok;
+    std::size_t records;
+    const char* error;
+};
+
+// Fixed-size scratch columns reused across chunks while streaming
+class FleetBinaryReader {
+private:
+    std::istream& in;
+    std::vector<double> health, uptime, rate, locX, locY, locZ;
+    std::vector<std::uint8_t> kStages, types, idLengths;
+    std::vector<std::uint16_t> queuePositions;
+    std::vector<char> idBytes;
+    
+    template<typename T>
+    bool readColumn(std::vector<T>& column, std::size_t count) {
+        column.resize(count);
+        in.read(reinterpret_cast<char*>(column.data()), count * sizeof(T));
+        return static_cast<std::size_t>(in.gcount()) == count * sizeof(T);
+    }
+    
+    template<typename T>
+    bool readValue(T& value) {
+        in.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return static_cast<std::size_t>(in.gcount()) == sizeof(T);
+    }
+
+public:
+    explicit FleetBinaryReader(std::istream& input) : in(input) {}
+    
+    IngestStatus load(FleetReliabilityManager& manager) {
+        char magic[4];
+        std::uint32_t version = 0;
+        std::uint64_t expected = 0;
+        
+        in.read(magic, sizeof(magic));
+        if(in.gcount() != sizeof(magic) || 
+           std::memcmp(magic, fleetBinaryMagic, sizeof(magic)) != 0) {
+            return {false, 0, "not a fleet binary file"};
+        }
+        if(!readValue(version) || version != fleetBinaryVersion) {
+            return {false, 0, "unsupported fleet binary version"};
+        }
+        if(!readValue(expected)) {
+            return {false, 0, "truncated header"};
+        }
+        if(expected > 0) {
+            manager.reserve(manager.size() + expected);
+        }
+        
+        std::size_t loaded = 0;
+        for(;;) {
+            std::uint32_t count = 0;
+            std::uint32_t idTotal = 0;
+            if(!readValue(count)) {
+                return {false, loaded, "truncated chunk header"};
+            }
+            if(count == 0) break;
+            if(count > fleetBinaryChunk || !readValue(idTotal)) {
+                return {false, loaded, "corrupt chunk header"};
+            }
+            
+            bool ok = readColumn(health, count) && readColumn(uptime, count) &&
+                      readColumn(rate, count) && readColumn(locX, count) &&
+                      readColumn(locY, count) && readColumn(locZ, count) &&
+                      readColumn(kStages, count) && readColumn(types, count) &&
+                      readColumn(queuePositions, count) &&
+                      readColumn(idLengths, count) && readColumn(idBytes, idTotal);
+            if(!ok) {
+                return {false, loaded, "truncated chunk"};
+            }
+            
+            std::size_t idSum = 0;
+            for(std::uint8_t len : idLengths) idSum += len;
+            if(idSum != idTotal) {
+                return {false, loaded, "id lengths do not match id bytes"};
+            }
+            
+            SensorChunk chunk = {count, health.data(), uptime.data(), rate.data(),
+                                 locX.data(), locY.data(), locZ.data(), 
+                                 kStages.data(), types.data(), queuePositions.data(),
+                                 idLengths.data(), idBytes.data()};
+            if(const char* error = chunk.validate()) {
+                return {false, loaded, error};
+            }
+            manager.addSensors(chunk);
+            loaded += count;
+        }
+        
+        return {true, loaded, nullptr};
+    }
+};
+
+IngestStatus loadFleetBinary(std::istream& in, FleetReliabilityManager& manager) {
+    return FleetBinaryReader(in).load(manager);
+}
+
+IngestStatus loadFleetBinary(const std::string& path, FleetReliabilityManager& manager) {
+    if(path == "-") {
+        return loadFleetBinary(std::cin, manager);
+    }
+    std::ifstream in(path, std::ios::binary);
+    if(!in) {
+        return {false, 0, "cannot open file"};
+    }
+    return loadFleetBinary(in, manager);
+}
+
+// Write the fleet in the binary columnar format, fleetBinaryChunk records
+// per chunk
+bool saveFleetBinary(std::ostream& out, const FleetColumns& store) {
+    auto writeValue = [&out](const auto& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    
+    out.write(fleetBinaryMagic, sizeof(fleetBinaryMagic));
+    writeValue(fleetBinaryVersion);
+    writeValue(static_cast<std::uint64_t>(store.count));
+    
+    std::vector<std::uint8_t> bytes;
+    std::vector<std::uint16_t> queue;
+    std::vector<char> ids;
+    
+    for(std::size_t base = 0; base < store.count; base += fleetBinaryChunk) {
+        const std::size_t count = std::min(fleetBinaryChunk, store.count - base);
+        
+        ids.clear();
+        for(std::size_t i = base; i < base + count; ++i) {
+            std::string_view id = store.getId(i).substr(0, 255);
+            ids.insert(ids.end(), id.begin(), id.end());
+        }
+        writeValue(static_cast<std::uint32_t>(count));
+        writeValue(static_cast<std::uint32_t>(ids.size()));
+        
+        auto writeDoubles = [&](const double* column) {
+            out.write(reinterpret_cast<const char*>(column + base), count * sizeof(double));
+        };
+        writeDoubles(store.health);
+        writeDoubles(store.uptimeHours);
+        writeDoubles(store.failureRate);
+        writeDoubles(store.locX);
+        writeDoubles(store.locY);
+        writeDoubles(store.locZ);
+        
+        bytes.resize(count);
+        for(std::size_t i = 0; i < count; ++i) {
+            bytes[i] = static_cast<std::uint8_t>(store.kStages[base + i]);
+        }
+        out.write(reinterpret_cast<const char*>(bytes.data()), count);
+        for(std::size_t i = 0; i < count; ++i) {
+            bytes[i] = static_cast<std::uint8_t>(store.types[base + i]);
+        }
+        out.write(reinterpret_cast<const char*>(bytes.data()), count);
+        
+        queue.resize(count);
+        for(std::size_t i = 0; i < count; ++i) {
+            queue[i] = static_cast<std::uint16_t>(store.queuePositions[base + i]);
+        }
+        out.write(reinterpret_cast<const char*>(queue.data()), count * sizeof(std::uint16_t));
+        
+        for(std::size_t i = 0; i < count; ++i) {
+            bytes[i] = static_cast<std::uint8_t>(std::min<std::size_t>(
+                store.getId(base + i).size(), 255));
+        }
+        out.write(reinterpret_cast<const char*>(bytes.data()), count);
+        out.write(ids.data(), ids.size());
+    }
+    
+    writeValue(static_cast<std::uint32_t>(0));
+    return static_cast<bool>(out);
+}
+
+// Shard protocol for coordinator mode. A request is the magic, version,
+// horizon, top-K size and the shard's number; the reply is one framed
+// FleetSummary (u32 byte length, then the body). Host byte order, like the
+// fleet binary format.
+constexpr char shardRequestMagic[4] = {'I', 'O', 'T', 'Q'};
+constexpr char fleetSummaryMagic[4] = {'I', 'O', 'T', 'P'};
+constexpr std::uint32_t shardProtocolVersion = 1;
+
+struct ShardRequest {
+    double timeHorizon;
+    std::uint32_t topK;
+    std::uint32_t shard;
+};
+
+bool writeShardRequest(std::ostream& out, const ShardRequest& request) {
+    out.write(shardRequestMagic, sizeof(shardRequestMagic));
+    out.write(reinterpret_cast<const char*>(&shardProtocolVersion), sizeof(shardProtocolVersion));
+    out.write(reinterpret_cast<const char*>(&request.timeHorizon), sizeof(request.timeHorizon));
+    out.write(reinterpret_cast<const char*>(&request.topK), sizeof(request.topK));
+    out.write(reinterpret_cast<const char*>(&request.shard), sizeof(request.shard));
+    return static_cast<bool>(out);
+}
+
+bool readShardRequest(std::istream& in, ShardRequest& request) {
+    char magic[4];
+    std::uint32_t version = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&request.timeHorizon), sizeof(request.timeHorizon));
+    in.read(reinterpret_cast<char*>(&request.topK), sizeof(request.topK));
+    in.read(reinterpret_cast<char*>(&request.shard), sizeof(request.shard));
+    return in && std::memcmp(magic, shardRequestMagic, sizeof(magic)) == 0 &&
+           version == shardProtocolVersion;
+}
+
+bool writeFleetSummary(std::ostream& out, const FleetSummary& summary) {
+    auto writeValue = [&out](const auto& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    
+    out.write(fleetSummaryMagic, sizeof(fleetSummaryMagic));
+    writeValue(shardProtocolVersion);
+    writeValue(summary.timeHorizon);
+    writeValue(summary.count);
+    writeValue(summary.mtbfSum);
+    writeValue(summary.mttfSum);
+    writeValue(summary.reliabilitySum);
+    writeValue(summary.active);
+    writeValue(summary.warning);
+    writeValue(summary.failed);
+    writeValue(summary.cascadeFailures);
+    writeValue(summary.topK);
+    writeValue(static_cast<std::uint32_t>(summary.atRisk.size()));
+    for(const auto& entry : summary.atRisk) {
+        const auto length = static_cast<std::uint8_t>(std::min<std::size_t>(entry.id.size(), 255));
+        writeValue(entry.shard);
+        writeValue(entry.slot);
+        writeValue(entry.failureProbability);
+        writeValue(length);
+        out.write(entry.id.data(), length);
+    }
+    return static_cast<bool>(out);
+}
+
+bool readFleetSummary(std::istream& in, FleetSummary& summary) {
+    auto readValue = [&in](auto& value) {
+        in.read(reinterpret_cast<char*>(&value), sizeof(value));
+        return static_cast<std::size_t>(in.gcount()) == sizeof(value);
+    };
+    
+    char magic[4];
+    std::uint32_t version = 0, entries = 0;
+    in.read(magic, sizeof(magic));
+    if(in.gcount() != sizeof(magic) || std::memcmp(magic, fleetSummaryMagic, sizeof(magic)) != 0 ||
+       !readValue(version) || version != shardProtocolVersion) {
+        return false;
+    }
+    summary = FleetSummary();
+    if(!(readValue(summary.timeHorizon) && readValue(summary.count) &&
+         readValue(summary.mtbfSum) && readValue(summary.mttfSum) &&
+         readValue(summary.reliabilitySum) && readValue(summary.active) &&
+         readValue(summary.warning) && readValue(summary.failed) &&
+         readValue(summary.cascadeFailures) && readValue(summary.topK) &&
+         readValue(entries)) || entries > summary.topK) {
+        return false;
+    }
+    summary.atRisk.resize(entries);
+    for(auto& entry : summary.atRisk) {
+        std::uint8_t length = 0;
+        if(!(readValue(entry.shard) && readValue(entry.slot) &&
+             readValue(entry.failureProbability) && readValue(length))) {
+            return false;
+        }
+        entry.id.resize(length);
+        in.read(&entry.id[0], length);
+        if(in.gcount() != length) return false;
+    }
+    return true;
+}
+
+// Shard side of coordinator mode: answer requests from in until it ends.
+// Returns false on a malformed request or a failed write.
+bool serveShard(const FleetReliabilityManager& manager, std::istream& in, std::ostream& out) {
+    for(;;) {
+        if(in.peek() == std::char_traits<char>::eof()) return true;
+        ShardRequest request;
+        if(!readShardRequest(in, request)) return false;
+        
+        std::ostringstream body;
+        writeFleetSummary(body, manager.summarize(request.timeHorizon, request.topK,
+                                                  request.shard));
+        const std::string reply = body.str();
+        const auto length = static_cast<std::uint32_t>(reply.size());
+        out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        out.write(reply.data(), reply.size());
+        out.flush();
+        if(!out) return false;
+    }
+}
+
+#ifdef RELIABILITY_HAVE_PROCESSES
+// Coordinator mode: each shard is a process running `--serve-shard` over
+// its part of the fleet, started through /bin/sh (so it may be remote, e.g.
+// via ssh) and connected by a socket pair. A query is sent to every shard
+// before any reply is read, so shards work concurrently; replies are merged
+// in shard order.
+class ShardCoordinator {
+private:
+    struct Shard {
+        pid_t pid;
+        int socket;
+        std::string command;
+    };
+    
+    std::vector<Shard> shardList;
+    
+    static bool sendAll(int fd, const void* data, std::size_t bytes) {
+        const char* p = static_cast<const char*>(data);
+        while(bytes > 0) {
+#ifdef MSG_NOSIGNAL
+            ssize_t sent = ::send(fd, p, bytes, MSG_NOSIGNAL);
+#else
+            ssize_t sent = ::send(fd, p, bytes, 0);
+#endif
+            if(sent < 0 && errno == EINTR) continue;
+            if(sent <= 0) return false;
+            p += sent;
+            bytes -= static_cast<std::size_t>(sent);
+        }
+        return true;
+    }
+    
+    static bool receiveAll(int fd, void* data, std::size_t bytes) {
+        char* p = static_cast<char*>(data);
+        while(bytes > 0) {
+            ssize_t got = ::recv(fd, p, bytes, 0);
+            if(got < 0 && errno == EINTR) continue;
+            if(got <= 0) return false;
+            p += got;
+            bytes -= static_cast<std::size_t>(got);
+        }
+        return true;
+    }
+    
+    // One length-framed reply; returns what went wrong, or nullptr
+    static const char* receiveReply(int fd, std::string& reply) {
+        std::uint32_t length = 0;
+        if(!receiveAll(fd, &length, sizeof(length))) return "no reply";
+        reply.assign(length, '\0');
+        if(length > 0 && !receiveAll(fd, &reply[0], length)) return "truncated reply";
+        return nullptr;
+    }
+    
+    // A shard whose stream broke mid-message can never be resynchronised;
+    // closing it ends the shard and makes every later query fail on it
+    static void markDown(Shard& shard) {
+        ::close(shard.socket);
+        shard.socket = -1;
+    }
+
+public:
+    ShardCoordinator() = default;
+    ShardCoordinator(const ShardCoordinator&) = delete;
+    ShardCoordinator& operator=(const ShardCoordinator&) = delete;
+    
+    // Closing the sockets ends each shard's input, so the shards exit
+    ~ShardCoordinator() {
+        for(const auto& shard : shardList) {
+            if(shard.socket >= 0) ::close(shard.socket);
+        }
+        for(const auto& shard : shardList) {
+            int status = 0;
+            while(::waitpid(shard.pid, &status, 0) < 0 && errno == EINTR) {}
+        }
+    }
+    
+    // Start `/bin/sh -c command` with its stdin and stdout on a socket.
+    // Both ends are close-on-exec so later shards do not inherit earlier
+    // shards' sockets (which would hold off their EOF); dup2 clears the
+    // flag on the child's stdin and stdout.
+    bool addShard(const std::string& command) {
+        int sockets[2];
+#ifdef SOCK_CLOEXEC
+        if(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sockets) != 0) return false;
+#else
+        if(::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0) return false;
+        ::fcntl(sockets[0], F_SETFD, FD_CLOEXEC);
+        ::fcntl(sockets[1], F_SETFD, FD_CLOEXEC);
+#endif
+        pid_t pid = ::fork();
+        if(pid < 0) {
+            ::close(sockets[0]);
+            ::close(sockets[1]);
+            return false;
+        }
+        if(pid == 0) {
+            ::close(sockets[0]);
+            ::dup2(sockets[1], STDIN_FILENO);
+            ::dup2(sockets[1], STDOUT_FILENO);
+            ::close(sockets[1]);
+            ::execl("/bin/sh", "sh", "-c", command.c_str(), static_cast<char*>(nullptr));
+            ::_exit(127);
+        }
+        ::close(sockets[1]);
+        shardList.push_back({pid, sockets[0], command});
+        return true;
+    }
+    
+    std::size_t shards() const {
+        return shardList.size();
+    }
+    
+    // Merged summary of every shard at timeHorizon with the k worst
+    // sensors overall; on failure, error names the first shard that failed.
+    // Every shard that got the request has its reply read before returning,
+    // so a failed query leaves no stale reply for the next one.
+    bool query(double timeHorizon, std::size_t k, FleetSummary& merged,
+               std::string* error = nullptr) {
+        bool ok = true;
+        auto fail = [error, &ok](const Shard& shard, const char* what) {
+            if(ok && error) *error = shard.command + ": " + what;
+            ok = false;
+        };
+        if(shardList.empty()) {
+            if(error) *error = "no shards";
+            return false;
+        }
+        for(const auto& shard : shardList) {
+            if(shard.socket < 0) {
+                fail(shard, "shard is down");
+                return false;
+            }
+        }
         
-        if(risk.riskFactor > 0.15) {
-            risk.riskLevel = "HIGH";
-        } else if(risk.riskFactor > 0.08) {
-            risk.riskLevel = "MEDIUM";
-        } else {
-            risk.riskLevel = "LOW";
+        std::size_t sent = 0;
+        for(; sent < shardList.size(); ++sent) {
+            std::ostringstream encoded;
+            writeShardRequest(encoded, {timeHorizon, static_cast<std::uint32_t>(k),
+                                        static_cast<std::uint32_t>(sent)});
+            const std::string request = encoded.str();
+            if(!sendAll(shardList[sent].socket, request.data(), request.size())) {
+                fail(shardList[sent], "request failed");
+                markDown(shardList[sent]);
+                break;
+            }
         }
         
-        return risk;
+        for(std::size_t i = 0; i < sent; ++i) {
+            std::string reply;
+            if(const char* what = receiveReply(shardList[i].socket, reply)) {
+                fail(shardList[i], what);
+                markDown(shardList[i]);
+                continue;
+            }
+            if(!ok) continue;
+            std::istringstream in(reply);
+            FleetSummary summary;
+            if(!readFleetSummary(in, summary)) {
+                fail(shardList[i], "malformed summary");
+            } else if(i == 0) {
+                merged = std::move(summary);
+            } else if(!merged.merge(summary)) {
+                fail(shardList[i], "summary does not match the query");
+            }
+        }
+        return ok;
     }
-    
-    const std::vector<std::shared_ptr<Sensor>>& getSensors() const {
-        return sensors;
+};
+#endif
+
+// C ABI (reliability_engine.h). Handles wrap a manager; column views and
+// batch kernels pass caller memory straight through without copies.
+static_assert(sizeof(int) == sizeof(std::int32_t), "C ABI exposes int columns as int32_t");
+static_assert(sizeof(SensorType) == sizeof(std::uint8_t), "C ABI exposes types as uint8_t");
+static_assert(sensorTypeCount == REL_SENSOR_TYPE_COUNT, "C ABI sensor type count");
+
+struct rel_fleet {
+    FleetReliabilityManager manager;
+};
+
+extern "C" {
+
+RELIABILITY_API std::uint32_t rel_abi_version(void) {
+    return RELIABILITY_ABI_VERSION;
+}
+
+RELIABILITY_API rel_fleet* rel_fleet_create(void) {
+    return new (std::nothrow) rel_fleet();
+}
+
+RELIABILITY_API void rel_fleet_destroy(rel_fleet* fleet) {
+    delete fleet;
+}
+
+RELIABILITY_API int rel_fleet_load(rel_fleet* fleet, const char* path) {
+    if(!fleet || !path) return REL_ERROR_ARGUMENT;
+    std::ifstream in(path, std::ios::binary);
+    if(!in) return REL_ERROR_IO;
+    return loadFleetBinary(in, fleet->manager).ok ? REL_OK : REL_ERROR_FORMAT;
+}
+
+RELIABILITY_API int rel_fleet_save(const rel_fleet* fleet, const char* path) {
+    if(!fleet || !path) return REL_ERROR_ARGUMENT;
+    std::ofstream out(path, std::ios::binary);
+    if(!out || !saveFleetBinary(out, fleet->manager.columns())) return REL_ERROR_IO;
+    return REL_OK;
+}
+
+RELIABILITY_API int rel_fleet_open_snapshot(rel_fleet* fleet, const char* path) {
+    if(!fleet || !path) return REL_ERROR_ARGUMENT;
+    return fleet->manager.openSnapshot(path) ? REL_OK : REL_ERROR_FORMAT;
+}
+
+RELIABILITY_API int rel_fleet_save_snapshot(const rel_fleet* fleet, const char* path) {
+    if(!fleet || !path) return REL_ERROR_ARGUMENT;
+    return fleet->manager.saveSnapshot(path) ? REL_OK : REL_ERROR_IO;
+}
+
+RELIABILITY_API void rel_fleet_set_parallel(rel_fleet* fleet, int parallel) {
+    if(!fleet) return;
+    fleet->manager.setExecutionMode(parallel ? ExecutionMode::PARALLEL : ExecutionMode::SERIAL);
+}
+
+RELIABILITY_API int rel_fleet_add_sensors(rel_fleet* fleet, std::uint64_t count,
+                                          const double* health, const double* uptime_hours,
+                                          const double* failure_rate, const double* loc_x,
+                                          const double* loc_y, const double* loc_z,
+                                          const std::uint8_t* k_stages, const std::uint8_t* types,
+                                          const std::uint16_t* queue_positions,
+                                          const std::uint8_t* id_lengths, const char* id_bytes) {
+    if(!fleet) return REL_ERROR_ARGUMENT;
+    if(count == 0) return REL_OK;
+    if(!health || !uptime_hours || !failure_rate || !loc_x || !loc_y || !loc_z ||
+       !k_stages || !types || !id_lengths || !id_bytes) {
+        return REL_ERROR_ARGUMENT;
+    }
+    std::vector<std::uint16_t> noQueue;
+    if(!queue_positions) {
+        noQueue.assign(count, 0);
+        queue_positions = noQueue.data();
+    }
+    SensorChunk chunk = {static_cast<std::size_t>(count), health, uptime_hours, failure_rate,
+                         loc_x, loc_y, loc_z, k_stages, types, queue_positions,
+                         id_lengths, id_bytes};
+    if(chunk.validate()) return REL_ERROR_ARGUMENT;
+    fleet->manager.addSensors(chunk);
+    return REL_OK;
+}
+
+RELIABILITY_API int rel_fleet_set_health(rel_fleet* fleet, const std::uint64_t* slots,
+                                         const double* health, std::uint64_t count) {
+    if(!fleet || (count > 0 && (!slots || !health))) return REL_ERROR_ARGUMENT;
+    const std::size_t n = fleet->manager.size();
+    for(std::uint64_t i = 0; i < count; ++i) {
+        if(slots[i] >= n) return REL_ERROR_ARGUMENT;
+    }
+    for(std::uint64_t i = 0; i < count; ++i) {
+        fleet->manager.setHealth(static_cast<std::size_t>(slots[i]), health[i]);
+    }
+    return REL_OK;
+}
+
+RELIABILITY_API std::uint64_t rel_fleet_size(const rel_fleet* fleet) {
+    return fleet ? fleet->manager.size() : 0;
+}
+
+RELIABILITY_API void rel_fleet_columns(const rel_fleet* fleet, rel_columns* out) {
+    if(!out) return;
+    *out = rel_columns{};
+    if(!fleet) return;
+    const FleetColumns c = fleet->manager.columns();
+    out->count = c.count;
+    for(std::size_t t = 0; t <= sensorTypeCount; ++t) {
+        out->type_begin[t] = c.typeBegin[t];
+    }
+    out->health = c.health;
+    out->failure_rate = c.failureRate;
+    out->k_stages = reinterpret_cast<const std::int32_t*>(c.kStages);
+    out->uptime_hours = c.uptimeHours;
+    out->types = reinterpret_cast<const std::uint8_t*>(c.types);
+    out->loc_x = c.locX;
+    out->loc_y = c.locY;
+    out->loc_z = c.locZ;
+    out->queue_positions = reinterpret_cast<const std::int32_t*>(c.queuePositions);
+    out->id_start = c.idStart;
+    out->id_length = c.idLength;
+    out->id_pool = c.idPool;
+}
+
+RELIABILITY_API double rel_fleet_mtbf(const rel_fleet* fleet) {
+    return fleet ? fleet->manager.calculateFleetMTBF() : 0.0;
+}
+
+RELIABILITY_API double rel_fleet_mttf(const rel_fleet* fleet) {
+    return fleet ? fleet->manager.calculateFleetMTTF() : 0.0;
+}
+
+RELIABILITY_API double rel_fleet_reliability(const rel_fleet* fleet, double horizon) {
+    return fleet ? fleet->manager.calculateFleetReliability(horizon) : 0.0;
+}
+
+RELIABILITY_API void rel_fleet_reliability_multi(const rel_fleet* fleet, const double* horizons,
+                                                 std::uint64_t count, double* out) {
+    if(!fleet || count == 0 || !horizons || !out) return;
+    fleet->manager.calculateFleetReliability(horizons, static_cast<std::size_t>(count), out);
+}
+
+// One fused pass over the fleet for the whole grid
+RELIABILITY_API void rel_fleet_reliability_curve(const rel_fleet* fleet, double t0, double dt,
+                                                 std::uint64_t n, double* out) {
+    if(!fleet || n == 0 || !out) return;
+    std::vector<double> horizons(n);
+    for(std::uint64_t i = 0; i < n; ++i) {
+        horizons[i] = t0 + i * dt;
+    }
+    fleet->manager.calculateFleetReliability(horizons.data(), horizons.size(), out);
+}
+
+RELIABILITY_API void rel_fleet_stats(const rel_fleet* fleet, rel_stats* out) {
+    if(!out) return;
+    *out = rel_stats{};
+    if(!fleet) return;
+    const auto stats = fleet->manager.getSensorStats();
+    *out = rel_stats{stats.total, stats.active, stats.warning, stats.failed};
+}
+
+RELIABILITY_API std::uint64_t rel_fleet_top_k_at_risk(const rel_fleet* fleet, std::uint64_t k,
+                                                      double horizon, std::uint64_t* slots,
+                                                      double* probabilities) {
+    if(!fleet || k == 0 || !slots || !probabilities) return 0;
+    const auto worst = fleet->manager.topKAtRisk(static_cast<std::size_t>(k), horizon);
+    for(std::size_t i = 0; i < worst.size(); ++i) {
+        slots[i] = worst[i].slot;
+        probabilities[i] = worst[i].failureProbability;
     }
+    return worst.size();
+}
+
+RELIABILITY_API void rel_exponential_reliability_batch(const double* rates, std::uint64_t n,
+                                                       double t, double* out) {
+    if(n == 0 || !rates || !out) return;
+    ExponentialModel::reliabilityBatch(rates, static_cast<std::size_t>(n), t, out);
+}
+
+RELIABILITY_API void rel_erlang_reliability_batch(const std::int32_t* k_stages, const double* rates,
+                                                  std::uint64_t n, double t, double* out) {
+    if(n == 0 || !k_stages || !rates || !out) return;
+    ErlangModel::reliabilityBatch(reinterpret_cast<const int*>(k_stages), rates,
+                                  static_cast<std::size_t>(n), t, out);
+}
+
+RELIABILITY_API void rel_erlang_reliability_curve(std::int32_t k_stages, double rate, double t0,
+                                                  double dt, std::uint64_t n, double* out) {
+    if(n == 0 || !out || k_stages < 1) return;
+    ErlangModel(k_stages, rate).reliabilityCurve(t0, dt, static_cast<std::size_t>(n), out);
+}
+
+RELIABILITY_API void rel_weibull_reliability_batch(const double* shapes, const double* scales,
+                                                   std::uint64_t n, double t, double* out) {
+    if(n == 0 || !shapes || !scales || !out) return;
+    WeibullModel::reliabilityBatch(shapes, scales, static_cast<std::size_t>(n), t, out);
+}
+
+}
+
+// Main program (left out of the shared library build)
+#ifndef RELIABILITY_ENGINE_NO_MAIN
+
+// Benchmark suite (--bench). Each result is one JSON object per line so
+// runs can be diffed and gated in CI.
+struct BenchConfig {
+    std::size_t minSensors = 1000;
+    std::size_t maxSensors = 1000000;   // fleet sizes are powers of ten in range
+    double minSeconds = 0.2;            // per measurement
+    std::string filter;                 // run benchmarks whose name contains this
 };
 
-// Initialize sample sensor network
-void initializeSensorNetwork(FleetReliabilityManager& manager) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<> locDist(5.0, 95.0);
-    std::uniform_real_distribution<> healthDist(20.0, 100.0);
-    std::uniform_real_distribution<> rateDist(0.0003, 0.0008);
-    std::uniform_int_distribution<> kDist(2, 5);
-    std::uniform_int_distribution<> queueDist(0, 9);
+struct BenchResult {
+    std::string name;
+    std::size_t sensors;         // fleet or batch size, 0 when not applicable
+    std::uint64_t iterations;
+    double nsPerOp;
+    double bytesPerSensor;       // 0 when not applicable
+};
+
+// Keeps benchmarked results alive without affecting timing
+inline volatile double benchSink = 0.0;
+
+// Time fn() with the iteration count doubled until one pass lasts
+// minSeconds; reports the best of three passes at that count
+template<typename Fn>
+std::pair<std::uint64_t, double> benchMeasure(Fn&& fn, double minSeconds) {
+    using Clock = std::chrono::steady_clock;
+    auto pass = [&](std::uint64_t iterations) {
+        auto start = Clock::now();
+        for(std::uint64_t i = 0; i < iterations; ++i) fn();
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    };
     
-    std::vector<SensorType> types = {
-        SensorType::TRAFFIC, 
-        SensorType::AIR_QUALITY, 
-        SensorType::WATER_FLOW
+    pass(1);
+    std::uint64_t iterations = 1;
+    double elapsed = pass(iterations);
+    while(elapsed < minSeconds && iterations < (std::uint64_t(1) << 40)) {
+        iterations *= 2;
+        elapsed = pass(iterations);
+    }
+    double best = elapsed;
+    for(int r = 0; r < 2; ++r) best = std::min(best, pass(iterations));
+    return {iterations, best * 1e9 / iterations};
+}
+
+inline void writeBenchResult(std::ostream& out, const BenchResult& r) {
+    double perSecond = r.nsPerOp > 0.0 ? 1e9 / r.nsPerOp : 0.0;
+    out << "{\"name\":\"" << r.name << "\",\"sensors\":" << r.sensors
+        << ",\"iterations\":" << r.iterations
+        << std::setprecision(6) << std::defaultfloat
+        << ",\"ns_per_op\":" << r.nsPerOp
+        << ",\"ops_per_sec\":" << perSecond
+        << ",\"sensors_per_sec\":" << (r.sensors ? perSecond * r.sensors : 0.0)
+        << ",\"bytes_per_sensor\":" << r.bytesPerSensor << "}" << std::endl;
+}
+
+// Deterministic synthetic fleet on a 1000 x 1000 grid
+inline void buildBenchFleet(FleetReliabilityManager& manager, std::size_t n) {
+    PhiloxStream rng(2024, 0);
+    manager.reserve(n, n * 11);
+    char id[24];
+    for(std::size_t i = 0; i < n; ++i) {
+        int len = std::snprintf(id, sizeof(id), "B-%09zu", i);
+        double u = rng.uniform();
+        manager.addSensor(std::string_view(id, static_cast<std::size_t>(len)),
+                          static_cast<SensorType>(i % 3),
+                          Location(rng.uniform() * 1000.0, rng.uniform() * 1000.0, 0.0),
+                          u < 0.05 ? 20.0 : 30.0 + 70.0 * rng.uniform(),
+                          1000.0 * rng.uniform(), 0.0005 + 0.002 * rng.uniform(),
+                          1 + static_cast<int>(i % 4), static_cast<int>(i % 100));
+    }
+}
+
+// Censored field history of n units drawn from a bathtub model: each unit
+// fails by its earliest mode unless inspected (censored) first
+inline LifetimeSample syntheticLifetimes(std::size_t n, std::uint64_t seed) {
+    const auto truth = CompetingRiskModel::bathtub(0.5, 5e5, 1.0 / 20000.0, 3.5, 9000.0);
+    const auto& modes = truth.components();
+    PhiloxStream rng(seed, 0);
+    LifetimeSample sample;
+    for(std::size_t i = 0; i < n; ++i) {
+        double age = 15000.0 * rng.uniform();
+        int cause = 0;
+        for(std::size_t c = 0; c < modes.size(); ++c) {
+            double t = modes[c].scale() * std::pow(-std::log(rng.uniform()), 1.0 / modes[c].shape());
+            if(t < age) {
+                age = t;
+                cause = static_cast<int>(c) + 1;
+            }
+        }
+        sample.add(age, cause);
+    }
+    return sample;
+}
+
+inline void runBenchmarks(const BenchConfig& config, std::ostream& out) {
+    auto run = [&](const std::string& name, std::size_t sensors, double bytesPerSensor, auto&& fn) {
+        if(!config.filter.empty() && name.find(config.filter) == std::string::npos) return;
+        auto [iterations, ns] = benchMeasure(fn, config.minSeconds);
+        writeBenchResult(out, {name, sensors, iterations, ns, bytesPerSensor});
     };
     
-    for(int i = 0; i < 50; ++i) {
-        std::string id = "SNS-" + std::string(4 - std::to_string(i+1).length(), '0') + 
-                        std::to_string(i+1);
+    // Model evaluation, scalar and batch
+    {
+        std::vector<double> rates(simd::blockSize * 16);
+        const std::size_t n = rates.size();
+        std::vector<double> times(n), result(n);
+        std::vector<int> stages(n);
+        for(std::size_t i = 0; i < n; ++i) {
+            rates[i] = 0.0005 + 0.002 * (i % 97) / 97.0;
+            times[i] = 10.0 * (i % 200);
+            stages[i] = 1 + static_cast<int>(i % 4);
+        }
+        ExponentialModel exponential(0.001);
+        ErlangModel erlang(3, 0.001);
         
-        Location loc(locDist(gen), locDist(gen), locDist(gen) / 30.0);
+        run("exponential.reliability.scalar", 1, 0.0, [&] {
+            benchSink = benchSink + exponential.reliability(500.0 + benchSink * 0.0);
+        });
+        run("exponential.reliability.batch", n, 0.0, [&] {
+            ExponentialModel::reliabilityBatch(rates.data(), n, 500.0, result.data());
+            benchSink = benchSink + result[n - 1];
+        });
+        run("exponential.reliability.times", n, 0.0, [&] {
+            exponential.reliability(times.data(), n, result.data());
+            benchSink = benchSink + result[n - 1];
+        });
+        run("erlang.reliability.scalar", 1, 0.0, [&] {
+            benchSink = benchSink + erlang.reliability(500.0 + benchSink * 0.0);
+        });
+        run("erlang.reliability.batch", n, 0.0, [&] {
+            ErlangModel::reliabilityBatch(stages.data(), rates.data(), n, 500.0, result.data());
+            benchSink = benchSink + result[n - 1];
+        });
+        run("erlang.reliability.times", n, 0.0, [&] {
+            erlang.reliability(times.data(), n, result.data());
+            benchSink = benchSink + result[n - 1];
+        });
         
-        auto sensor = std::make_shared<Sensor>(
-            id,
-            types[i % 3],
-            loc,
-            healthDist(gen),
-            1000.0 + i * 100.0,
-            rateDist(gen),
-            kDist(gen),
-            queueDist(gen)
-        );
+        std::vector<double> shapes(n), scales(n);
+        for(std::size_t i = 0; i < n; ++i) {
+            shapes[i] = 0.5 + 3.0 * (i % 89) / 89.0;
+            scales[i] = 1.0 / rates[i];
+        }
+        WeibullModel weibull(2.5, 1200.0);
+        auto bathtub = CompetingRiskModel::bathtub(0.5, 5e5, 1.0 / 20000.0, 3.5, 9000.0);
+        run("weibull.reliability.batch", n, 0.0, [&] {
+            WeibullModel::reliabilityBatch(shapes.data(), scales.data(), n, 500.0, result.data());
+            benchSink = benchSink + result[n - 1];
+        });
+        run("weibull.reliability.times", n, 0.0, [&] {
+            weibull.reliability(times.data(), n, result.data());
+            benchSink = benchSink + result[n - 1];
+        });
+        run("bathtub.reliability.times", n, 0.0, [&] {
+            bathtub.reliability(times.data(), n, result.data());
+            benchSink = benchSink + result[n - 1];
+        });
+    }
+    
+    // Competing-risk refit of a censored bathtub history
+    for(std::size_t n : {std::size_t(100000), std::size_t(1000000)}) {
+        if(n < config.minSensors || n > config.maxSensors) continue;
+        LifetimeSample sample = syntheticLifetimes(n, 2024);
+        FleetReliabilityManager manager;
+        std::string suffix = "." + std::to_string(n);
+        run("fit.bathtub" + suffix, n, 0.0, [&] {
+            benchSink = benchSink + manager.fitCompetingRisks(sample).logLikelihood;
+        });
+        manager.setExecutionMode(ExecutionMode::PARALLEL);
+        run("fit.bathtub.parallel" + suffix, n, 0.0, [&] {
+            benchSink = benchSink + manager.fitCompetingRisks(sample).logLikelihood;
+        });
+    }
+    
+    // Queueing at large server counts
+    for(int servers : {10, 1000, 100000}) {
+        double service = 0.15, arrival = 0.9 * servers * service;
+        std::string suffix = ".c" + std::to_string(servers);
+        run("queue.metrics" + suffix, 0, 0.0, [&] {
+            benchSink = benchSink + QueueingModel(arrival, service, servers).avgWaitTime();
+        });
+    }
+    
+    // Health history: one day of one-minute samples per sensor at 12-bit
+    // precision, then window scans that mostly skip on block summaries
+    for(std::size_t n : {std::size_t(10000), std::size_t(100000)}) {
+        if(n < config.minSensors || n > config.maxSensors) continue;
+        FleetReliabilityManager manager;
+        buildBenchFleet(manager, n);
+        manager.enableHealthHistory(12);
+        const std::int64_t start = 1700000000;
+        const std::int64_t minutes = 1440;
+        std::vector<double> level(n);
+        PhiloxStream rng(2024, 1);
+        for(std::size_t i = 0; i < n; ++i) level[i] = 40.0 + 60.0 * rng.uniform();
+        for(std::int64_t minute = 0; minute < minutes; ++minute) {
+            for(std::size_t i = 0; i < n; ++i) {
+                level[i] -= 0.01 * rng.uniform();
+                manager.recordHealth(i, start + minute * 60, level[i]);
+            }
+        }
+        const std::int64_t now = start + (minutes - 1) * 60;
+        const double bytes = static_cast<double>(manager.healthHistory()->memoryBytes()) / n;
+        std::string suffix = "." + std::to_string(n);
+        run("history.below.1h" + suffix, n, bytes, [&] {
+            benchSink = benchSink + manager.sensorsBelow(30.0, now - 3600, now).size();
+        });
+        run("history.below.24h" + suffix, n, bytes, [&] {
+            benchSink = benchSink + manager.sensorsBelow(30.0, now - 86400, now).size();
+        });
+        std::int64_t next = now;
+        std::size_t slot = 0;
+        run("history.append" + suffix, 1, bytes, [&] {
+            if(slot == 0) next += 60;
+            manager.recordHealth(slot, next, level[slot]);
+            slot = (slot + 1 == n) ? 0 : slot + 1;
+        });
+    }
+    
+    // Dashboard burst: 256 reliability requests over 8 horizons, answered
+    // one by one versus through the coalescing service (query cache off)
+    if(config.minSensors <= 100000 && config.maxSensors >= 100000) {
+        const std::size_t n = 100000;
+        FleetReliabilityManager manager;
+        buildBenchFleet(manager, n);
+        manager.setQueryCacheCapacity(0);
+        const double horizons[8] = {24, 168, 500, 720, 1000, 2000, 4380, 8760};
+        run("burst256.sync.100000", n, 0.0, [&] {
+            for(int i = 0; i < 256; ++i) {
+                benchSink = benchSink + manager.calculateFleetReliability(horizons[i % 8]);
+            }
+        });
+        QueryService service(manager);
+        run("burst256.service.100000", n, 0.0, [&] {
+            std::vector<std::future<double>> results;
+            results.reserve(256);
+            for(int i = 0; i < 256; ++i) {
+                results.push_back(service.fleetReliability(horizons[i % 8]));
+            }
+            for(auto& result : results) benchSink = benchSink + result.get();
+        });
+    }
+    
+    // Instrumentation cost of an empty probed scope (almost always untimed)
+    run("metrics.probe", 0, 0.0, [] { ApiProbe probe(MetricApi::FLEET_RELIABILITY); });
+    
+    // Fleet aggregates and ingest at each size
+    for(std::size_t n = config.minSensors; n <= config.maxSensors; n *= 10) {
+        FleetReliabilityManager manager;
+        using Clock = std::chrono::steady_clock;
+        auto start = Clock::now();
+        buildBenchFleet(manager, n);
+        double buildNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        double bytes = static_cast<double>(manager.memoryBytes()) / n;
+        std::string suffix = "." + std::to_string(n);
+        
+        if(config.filter.empty() || std::string("fleet.build").find(config.filter) != std::string::npos) {
+            writeBenchResult(out, {"fleet.build" + suffix, n, 1, buildNs, bytes});
+        }
+        
+        // Uncached query cost first; the cache gets its own cases below
+        manager.setQueryCacheCapacity(0);
+        run("fleet.mtbf" + suffix, n, bytes, [&] {
+            benchSink = benchSink + manager.calculateFleetMTBF();
+        });
+        run("fleet.mttf" + suffix, n, bytes, [&] {
+            benchSink = benchSink + manager.calculateFleetMTTF();
+        });
+        run("fleet.reliability" + suffix, n, bytes, [&] {
+            benchSink = benchSink + manager.calculateFleetReliability(1000.0);
+        });
+        run("fleet.stats" + suffix, n, bytes, [&] {
+            benchSink = benchSink + manager.getSensorStats().active;
+        });
+        run("fleet.cascade" + suffix, n, bytes, [&] {
+            benchSink = benchSink + manager.analyzeCascadeRisk().riskFactor;
+        });
+        run("fleet.snapshot" + suffix, n, bytes, [&] {
+            benchSink = benchSink + manager.computeSnapshot(1000.0).reliability;
+        });
+        run("fleet.curve64" + suffix, n, bytes, [&] {
+            double curve[64];
+            manager.calculateFleetReliabilityCurve(0.0, 50.0, 64, curve);
+            benchSink = benchSink + curve[63];
+        });
+        run("fleet.region" + suffix, n, bytes, [&] {
+            benchSink = benchSink + manager.getSensorStats(Region::box(400, 400, 600, 600)).total;
+        });
+        run("fleet.topk100" + suffix, n, bytes, [&] {
+            benchSink = benchSink + manager.topKAtRisk(100, 1000.0)[0].failureProbability;
+        });
+        run("fleet.summary.top100" + suffix, n, bytes, [&] {
+            std::ostringstream encoded;
+            writeFleetSummary(encoded, manager.summarize(1000.0, 100));
+            benchSink = benchSink + static_cast<double>(encoded.tellp());
+        });
+        run("fleet.type.reliability" + suffix, n, bytes, [&] {
+            benchSink = benchSink + manager.calculateFleetReliability(1000.0, SensorType::AIR_QUALITY);
+        });
+        run("fleet.types" + suffix, n, bytes, [&] {
+            benchSink = benchSink + manager.computeTypeSnapshots(1000.0)[0].reliability;
+        });
+        // 5 rate multipliers x 8 horizons x 10 crew sizes
+        ScenarioGrid grid;
+        grid.rateMultipliers = {1.0, 1.1, 1.2, 1.35, 1.5};
+        grid.horizons = {250.0, 500.0, 750.0, 1000.0, 1500.0, 2000.0, 3000.0, 4000.0};
+        grid.crews = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+        run("fleet.sweep.5x8x10" + suffix, n, bytes, [&] {
+            benchSink = benchSink + manager.sweepScenarios(grid).reliability[0];
+        });
+        
+        manager.setExecutionMode(ExecutionMode::PARALLEL);
+        run("fleet.reliability.parallel" + suffix, n, bytes, [&] {
+            benchSink = benchSink + manager.calculateFleetReliability(1000.0);
+        });
+        run("fleet.snapshot.parallel" + suffix, n, bytes, [&] {
+            benchSink = benchSink + manager.computeSnapshot(1000.0).reliability;
+        });
+        run("fleet.types.parallel" + suffix, n, bytes, [&] {
+            benchSink = benchSink + manager.computeTypeSnapshots(1000.0)[0].reliability;
+        });
+        run("fleet.sweep.5x8x10.parallel" + suffix, n, bytes, [&] {
+            benchSink = benchSink + manager.sweepScenarios(grid).reliability[0];
+        });
+        manager.setNumaSharding();
+        run("fleet.reliability.numa" + suffix, n, bytes, [&] {
+            benchSink = benchSink + manager.calculateFleetReliability(1000.0);
+        });
+        run("fleet.snapshot.numa" + suffix, n, bytes, [&] {
+            benchSink = benchSink + manager.computeSnapshot(1000.0).reliability;
+        });
+        manager.setNumaSharding(nullptr);
+        manager.setExecutionMode(ExecutionMode::SERIAL);
+        
+        const Region district = Region::box(400, 400, 600, 600);
+        manager.setQueryCacheCapacity(16);
+        run("cache.reliability.hit" + suffix, n, bytes, [&] {
+            benchSink = benchSink + manager.calculateFleetReliability(1000.0);
+        });
+        run("cache.region.hit" + suffix, n, bytes, [&] {
+            benchSink = benchSink + manager.getSensorStats(district).total;
+        });
+        std::size_t updated = 0;
+        run("cache.region.patched" + suffix, n, bytes, [&] {
+            manager.setHealth(updated++ % n, 55.0);
+            benchSink = benchSink + manager.getSensorStats(district).total;
+        });
+        
+        if(n <= 10000000) {
+            std::stringstream encoded;
+            saveFleetBinary(encoded, manager.columns());
+            const std::string bytesOut = encoded.str();
+            run("ingest.binary" + suffix, n, static_cast<double>(bytesOut.size()) / n, [&] {
+                std::istringstream in(bytesOut);
+                FleetReliabilityManager loaded;
+                benchSink = benchSink + loadFleetBinary(in, loaded).records;
+            });
+        }
+        
+        if(n > config.maxSensors / 10) break;
+    }
+}
+
+// Small fleet for the self-test: sensor i at (i, 0) with stage count 2;
+// the first failed of them below 30% health, the rest healthy
+inline void buildSelfTestFleet(FleetReliabilityManager& manager, std::size_t n, std::size_t failed) {
+    for(std::size_t i = 0; i < n; ++i) {
+        manager.addSensor("T" + std::to_string(i), static_cast<SensorType>(i % sensorTypeCount),
+                          Location(static_cast<double>(i), 0.0, 0.0), i < failed ? 10.0 : 90.0,
+                          1000.0, 1e-3, 2, 0);
+    }
+}
+
+// Regression checks for the validation and consistency paths: graph and
+// fleet size, corrupt snapshots, concurrent health with the query cache,
+// empty regions and the C ABI argument checks. Prints one line per check
+// and returns false if any failed. Build with -fsanitize=address,undefined
+// so that an out-of-bounds access fails the run as well.
+inline bool runSelfTest(std::ostream& out) {
+    int failures = 0;
+    auto check = [&](const char* name, bool ok) {
+        out << (ok ? "ok   " : "FAIL ") << name << std::endl;
+        if(!ok) ++failures;
+    };
+    
+    // Dependency graph against the fleet size
+    {
+        FleetReliabilityManager manager;
+        buildSelfTestFleet(manager, 10, 3);
+        std::vector<DependencyGraph::Edge> edges;
+        for(std::uint32_t u = 0; u < 20; ++u) edges.push_back({u, (u + 7) % 20, 0.5});
+        check("graph.rejects_oversized", !manager.setDependencyGraph(DependencyGraph::fromEdges(20, edges)) &&
+                                         manager.getDependencyGraph().empty());
+        auto kernel = propagateFailures(DependencyGraph::fromEdges(20, edges), 
+                                        manager.columns().health, manager.size(), nullptr, 32, 1e-6);
+        check("graph.kernel_ignores_outside_nodes", kernel.failureProbability.size() == 10 &&
+                                                    kernel.seeds == 3);
+        check("graph.accepts_fitting", manager.setDependencyGraph(manager.buildProximityGraph(3.0, 0.5)) &&
+                                       manager.propagateCascade().expectedAdditional > 0.0);
+        manager.removeSensor(0);
+        check("graph.cleared_on_remove", manager.getDependencyGraph().empty());
+    }
+    
+#ifdef RELIABILITY_HAVE_MMAP
+    // Snapshots: each corruption must be rejected on open
+    {
+        FleetReliabilityManager source;
+        buildSelfTestFleet(source, 64, 5);
+        const char* dir = std::getenv("TMPDIR");
+        std::string path = std::string(dir && *dir ? dir : "/tmp") + "/reliability_selftest_" +
+                           std::to_string(::getpid()) + ".snap";
+        bool saved = source.saveSnapshot(path);
+        std::string clean;
+        if(saved) {
+            std::ifstream in(path, std::ios::binary);
+            clean.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        check("snapshot.save", saved && clean.size() >= sizeof(FleetSnapshotHeader));
+        if(saved && clean.size() >= sizeof(FleetSnapshotHeader)) {
+            FleetSnapshotHeader h;
+            std::memcpy(&h, clean.data(), sizeof(h));
+            auto opensAs = [&](const std::string& bytes) {
+                std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), bytes.size());
+                FleetReliabilityManager target;
+                return target.openSnapshot(path);
+            };
+            auto corrupt = [&](auto mutate) {
+                std::string bytes = clean;
+                mutate(bytes);
+                return !opensAs(bytes);
+            };
+            auto patch = [](std::string& bytes, std::uint64_t offset, auto value) {
+                std::memcpy(&bytes[offset], &value, sizeof(value));
+            };
+            check("snapshot.rejects_unknown_type", corrupt([&](std::string& b) {
+                b[h.columnOffset[SNAP_TYPE]] = char(200);
+            }));
+            check("snapshot.rejects_type_outside_partition", corrupt([&](std::string& b) {
+                b[h.columnOffset[SNAP_TYPE]] = char(sensorTypeCount - 1);
+            }));
+            check("snapshot.rejects_zero_stages", corrupt([&](std::string& b) {
+                patch(b, h.columnOffset[SNAP_K] + sizeof(int), int(0));
+            }));
+            check("snapshot.rejects_id_extent", corrupt([&](std::string& b) {
+                patch(b, h.columnOffset[SNAP_ID_LENGTH], std::uint32_t(0xFFFFFFFFu));
+            }));
+            check("snapshot.rejects_id_index_size", corrupt([&](std::string& b) {
+                patch(b, offsetof(FleetSnapshotHeader, idIndexBuckets), std::uint64_t(1) << 60);
+            }));
+            check("snapshot.rejects_truncated", corrupt([&](std::string& b) {
+                b.resize(b.size() / 2);
+            }));
+            
+            std::ofstream(path, std::ios::binary | std::ios::trunc).write(clean.data(), clean.size());
+            FleetReliabilityManager mapped;
+            bool opened = mapped.openSnapshot(path);
+            // Mapped fleets read the full columns, so hot-record builds differ
+            // from the source in float rounding
+            check("snapshot.opens_clean", opened && mapped.size() == source.size() &&
+                  mapped.calculateFleetMTBF() == source.calculateFleetMTBF() &&
+                  std::abs(mapped.calculateFleetReliability(1000.0) - 
+                           source.calculateFleetReliability(1000.0)) < 1e-6);
+            if(opened) {
+                mapped.setHealth(0, 50.0);
+                mapped.removeSensor(1);
+                check("snapshot.mutates_after_open", mapped.getSensorStats().total == 63);
+            }
+        }
+        std::remove(path.c_str());
+    }
+#endif
+    
+    // Concurrent health mode against the query cache and the snapshot board
+    {
+        FleetReliabilityManager manager;
+        buildSelfTestFleet(manager, 10, 0);
+        const Region all = Region::box(-1.0, -1.0, 100.0, 100.0);
+        bool before = manager.getSensorStats(all).failed == 0;
+        manager.beginConcurrentHealth();
+        for(std::size_t i = 0; i < manager.size(); ++i) manager.publishHealth(i, 10.0);
+        check("health.concurrent_bypasses_cache", before && manager.getSensorStats(all).failed == 10);
+        check("health.publish_rejects_slot", !manager.publishHealth(manager.size(), 10.0));
+        manager.endConcurrentHealth();
+        check("health.folded_back", manager.getSensorStats(all).failed == 10);
+        
+        // Recycled snapshot buffers must match the published state and never
+        // change while pinned
+        const std::size_t n = 257;
+        std::vector<double> truth(n, 80.0);
+        HealthTally tally;
+        for(double v : truth) tally.add(v, +1);
+        ConcurrentHealthBoard board(truth.data(), n, tally);
+        std::vector<std::pair<std::shared_ptr<const HealthSnapshot>, std::vector<double>>> pinned;
+        std::uint64_t state = 12345;
+        auto next = [&state] { state = state * 6364136223846793005ull + 1442695040888963407ull; return state >> 33; };
+        bool matches = true;
+        for(int step = 0; step < 2000 && matches; ++step) {
+            for(std::uint64_t u = next() % 6; u > 0; --u) {
+                std::size_t slot = next() % n;
+                truth[slot] = static_cast<double>(next() % 1000) / 10.0;
+                board.publish(slot, truth[slot]);
+            }
+            auto snapshot = board.acquire();
+            HealthTally expected;
+            for(double v : truth) expected.add(v, +1);
+            matches = std::equal(truth.begin(), truth.end(), snapshot->health.begin()) &&
+                      snapshot->tally.active == expected.active && 
+                      snapshot->tally.warning == expected.warning &&
+                      snapshot->tally.failed == expected.failed;
+            for(const auto& pin : pinned) {
+                matches = matches && std::equal(pin.second.begin(), pin.second.end(), pin.first->health.begin());
+            }
+            if(next() % 4 == 0) pinned.emplace_back(snapshot, truth);
+            if(pinned.size() > 3 || (!pinned.empty() && next() % 3 == 0)) pinned.erase(pinned.begin());
+        }
+        check("health.snapshot_recycling", matches);
+    }
+    
+    // Empty sets: nothing can fail
+    {
+        FleetReliabilityManager manager;
+        buildSelfTestFleet(manager, 10, 2);
+        const Region nowhere = Region::box(500.0, 500.0, 600.0, 600.0);
+        check("region.empty_reliability", manager.calculateFleetReliability(100.0, nowhere) == 1.0 &&
+                                          manager.calculateFleetReliability(100.0, nowhere) == 1.0);
+        check("region.empty_stats", manager.getSensorStats(nowhere).total == 0);
+        QueryService service(manager);
+        check("region.empty_service", service.fleetReliability(100.0, nowhere).get() == 1.0);
         
-        manager.addSensor(sensor);
+        FleetReliabilityManager empty;
+        double curve[2];
+        empty.calculateFleetReliabilityCurve(0.0, 10.0, 2, curve);
+        check("fleet.empty_reliability", empty.calculateFleetReliability(100.0) == 1.0 &&
+                                         curve[0] == 1.0 && curve[1] == 1.0);
+    }
+    
+    // C ABI argument checks the Python wrapper relies on
+    {
+        rel_fleet* fleet = rel_fleet_create();
+        double health[2] = {90.0, 50.0}, uptime[2] = {1.0, 2.0}, rate[2] = {1e-3, 2e-3};
+        double loc[2] = {0.0, 1.0};
+        std::uint8_t goodStages[2] = {2, 3}, zeroStages[2] = {2, 0};
+        std::uint8_t goodTypes[2] = {0, 1}, badTypes[2] = {0, sensorTypeCount};
+        std::uint8_t idLengths[2] = {2, 2};
+        const char ids[] = "AABB";
+        check("cabi.rejects_zero_stages", 
+              rel_fleet_add_sensors(fleet, 2, health, uptime, rate, loc, loc, loc, zeroStages,
+                                    goodTypes, nullptr, idLengths, ids) == REL_ERROR_ARGUMENT);
+        check("cabi.rejects_unknown_type",
+              rel_fleet_add_sensors(fleet, 2, health, uptime, rate, loc, loc, loc, goodStages,
+                                    badTypes, nullptr, idLengths, ids) == REL_ERROR_ARGUMENT);
+        check("cabi.adds_valid",
+              rel_fleet_add_sensors(fleet, 2, health, uptime, rate, loc, loc, loc, goodStages,
+                                    goodTypes, nullptr, idLengths, ids) == REL_OK &&
+              rel_fleet_size(fleet) == 2);
+        std::uint64_t slot = 2;
+        check("cabi.set_health_rejects_slot", 
+              rel_fleet_set_health(fleet, &slot, health, 1) == REL_ERROR_ARGUMENT);
+        rel_fleet_destroy(fleet);
     }
+    
+    out << (failures ? "self-test FAILED: " : "self-test passed: ") << failures << " failing" << std::endl;
+    return failures == 0;
 }
 
-// Main program
-int main() {
+int main(int argc, char** argv) {
+    // Initialize fleet manager: --open <snapshot> maps a fleet snapshot,
+    // --load <file|-> streams a binary fleet, otherwise a synthetic network
+    // is generated; --save / --save-snapshot write the fleet out. --bench
+    // runs the benchmark suite instead and prints JSON lines; --selftest
+    // runs the regression checks and exits non-zero on a failure; --metrics
+    // appends the engine metrics in Prometheus text format. --serve-shard
+    // answers coordinator requests on stdin/stdout for the loaded fleet;
+    // each --shard <command> starts one such shard, and the merged fleet
+    // is reported instead of a local one.
+    std::string loadPath, savePath, openPath, snapshotPath;
+    std::vector<std::string> shardCommands;
+    BenchConfig bench;
+    bool runBench = false, runChecks = false, printMetrics = false, serveMode = false;
+    for(int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if(arg == "--bench") { runBench = true; continue; }
+        if(arg == "--selftest") { runChecks = true; continue; }
+        if(arg == "--metrics") { printMetrics = true; continue; }
+        if(arg == "--serve-shard") { serveMode = true; continue; }
+        if(i + 1 >= argc) break;
+        if(arg == "--bench-max") bench.maxSensors = std::stoull(argv[++i]);
+        else if(arg == "--bench-min") bench.minSensors = std::stoull(argv[++i]);
+        else if(arg == "--bench-time") bench.minSeconds = std::stod(argv[++i]);
+        else if(arg == "--bench-filter") bench.filter = argv[++i];
+        else if(arg == "--load") loadPath = argv[++i];
+        else if(arg == "--save") savePath = argv[++i];
+        else if(arg == "--open") openPath = argv[++i];
+        else if(arg == "--save-snapshot") snapshotPath = argv[++i];
+        else if(arg == "--shard") shardCommands.push_back(argv[++i]);
+    }
+    
+    if(runBench) {
+        runBenchmarks(bench, std::cout);
+        return 0;
+    }
+    
+    if(runChecks) {
+        return runSelfTest(std::cout) ? 0 : 1;
+    }
+    
+    // Shard process: stdout carries the protocol, so nothing else is printed
+    if(serveMode) {
+        FleetReliabilityManager manager;
+        if(!openPath.empty()) {
+            if(!manager.openSnapshot(openPath)) {
+                std::cerr << "Failed to open snapshot " << openPath << std::endl;
+                return 1;
+            }
+        } else if(!loadPath.empty()) {
+            IngestStatus status = loadFleetBinary(loadPath, manager);
+            if(!status.ok) {
+                std::cerr << "Failed to load " << loadPath << ": " << status.error << std::endl;
+                return 1;
+            }
+        } else {
+            initializeSensorNetwork(manager);
+        }
+        return serveShard(manager, std::cin, std::cout) ? 0 : 1;
+    }
+    
+#ifdef RELIABILITY_HAVE_PROCESSES
+    if(!shardCommands.empty()) {
+        ShardCoordinator coordinator;
+        for(const auto& command : shardCommands) {
+            if(!coordinator.addShard(command)) {
+                std::cerr << "Failed to start shard: " << command << std::endl;
+                return 1;
+            }
+        }
+        FleetSummary merged;
+        std::string error;
+        if(!coordinator.query(1000.0, 5, merged, &error)) {
+            std::cerr << "Shard query failed: " << error << std::endl;
+            return 1;
+        }
+        
+        auto snapshot = FleetReliabilityManager::snapshotFromSummary(merged);
+        std::cout << "=== Coordinated Fleet (" << coordinator.shards() << " shards) ===" << std::endl;
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "Total Sensors: " << snapshot.stats.total << std::endl;
+        std::cout << "Fleet MTBF: " << snapshot.mtbf << " hours" << std::endl;
+        std::cout << "Fleet MTTF: " << snapshot.mttf << " hours" << std::endl;
+        std::cout << "Fleet Reliability (1000h): " << snapshot.reliability * 100.0 << "%" << std::endl;
+        std::cout << "Active/Warning/Failed: " << snapshot.stats.active << "/"
+                  << snapshot.stats.warning << "/" << snapshot.stats.failed << std::endl;
+        std::cout << "Cascade Risk Factor: " << snapshot.cascade.riskFactor * 100.0 << "%" << std::endl;
+        for(const auto& risk : merged.atRisk) {
+            std::cout << risk.id << " (shard " << risk.shard << "): "
+                      << risk.failureProbability * 100.0 << "% failure probability" << std::endl;
+        }
+        return 0;
+    }
+#endif
+    
     std::cout << "=================================================" << std::endl;
     std::cout << "IoT Sensor Network Reliability Tracker - C++" << std::endl;
     std::cout << "=================================================" << std::endl;
     std::cout << std::endl;
     
-    // Initialize fleet manager
     FleetReliabilityManager manager;
-    initializeSensorNetwork(manager);
+    if(!openPath.empty()) {
+        if(!manager.openSnapshot(openPath)) {
+            std::cerr << "Failed to open snapshot " << openPath << std::endl;
+            return 1;
+        }
+        std::cout << "Mapped " << manager.size() << " sensors from " << openPath 
+                  << std::endl << std::endl;
+    } else if(!loadPath.empty()) {
+        IngestStatus status = loadFleetBinary(loadPath, manager);
+        if(!status.ok) {
+            std::cerr << "Failed to load " << loadPath << ": " << status.error 
+                      << " (after " << status.records << " records)" << std::endl;
+            return 1;
+        }
+        std::cout << "Loaded " << status.records << " sensors from " << loadPath 
+                  << std::endl << std::endl;
+    } else {
+        initializeSensorNetwork(manager);
+    }
+    
+    if(!savePath.empty()) {
+        std::ofstream out(savePath, std::ios::binary);
+        if(!out || !saveFleetBinary(out, manager.columns())) {
+            std::cerr << "Failed to save " << savePath << std::endl;
+            return 1;
+        }
+    }
+    if(!snapshotPath.empty() && !manager.saveSnapshot(snapshotPath)) {
+        std::cerr << "Failed to save snapshot " << snapshotPath << std::endl;
+        return 1;
+    }
     
-    // Calculate fleet metrics
+    // Calculate fleet metrics in one pass
+    auto snapshot = manager.computeSnapshot(1000.0);
     std::cout << "=== Fleet Reliability Metrics ===" << std::endl;
     std::cout << std::fixed << std::setprecision(2);
-    std::cout << "Fleet MTBF: " << manager.calculateFleetMTBF() << " hours" << std::endl;
-    std::cout << "Fleet MTTF: " << manager.calculateFleetMTTF() << " hours" << std::endl;
+    std::cout << "Fleet MTBF: " << snapshot.mtbf << " hours" << std::endl;
+    std::cout << "Fleet MTTF: " << snapshot.mttf << " hours" << std::endl;
     std::cout << "Fleet Reliability (1000h): " 
-              << manager.calculateFleetReliability(1000.0) * 100.0 << "%" << std::endl;
+              << snapshot.reliability * 100.0 << "%" << std::endl;
     std::cout << std::endl;
     
     // Sensor statistics
-    auto stats = manager.getSensorStats();
+    const auto& stats = snapshot.stats;
     std::cout << "=== Sensor Statistics ===" << std::endl;
     std::cout << "Total Sensors: " << stats.total << std::endl;
     std::cout << "Active (>70%): " << stats.active << std::endl;
@@ -380,6 +8033,53 @@ int main() {
     std::cout << "Failed (<30%): " << stats.failed << std::endl;
     std::cout << std::endl;
     
+    // Per-type breakdown from the partitioned store
+    auto byType = manager.computeTypeSnapshots(1000.0);
+    std::cout << "=== Breakdown by Sensor Type ===" << std::endl;
+    for(std::size_t t = 0; t < sensorTypeCount; ++t) {
+        const auto& typed = byType[t];
+        if(typed.stats.total == 0) continue;
+        SensorType type = static_cast<SensorType>(t);
+        std::cout << sensorTypeName(type) << ": " << typed.stats.total << " sensors, "
+                  << "MTBF " << typed.mtbf << "h, "
+                  << "R(1000h) " << typed.reliability * 100.0 << "%, "
+                  << typed.stats.failed << " failed, "
+                  << "Erlang-" << manager.typicalStages(type) << std::endl;
+    }
+    std::cout << std::endl;
+    
+    // Concurrent dashboard clients through the coalescing query service
+    {
+        QueryService service(manager);
+        std::vector<std::thread> clients;
+        std::vector<double> answers(8);
+        for(int client = 0; client < 8; ++client) {
+            clients.emplace_back([&service, &answers, client] {
+                const double horizon = (client % 2) ? 720.0 : 1000.0;
+                std::vector<std::future<double>> pending;
+                for(int i = 0; i < 25; ++i) pending.push_back(service.fleetReliability(horizon));
+                for(auto& result : pending) answers[client] = result.get();
+            });
+        }
+        for(auto& client : clients) client.join();
+        QueryServiceStats served = service.stats();
+        std::cout << "=== Query Service (8 clients x 25 requests) ===" << std::endl;
+        std::cout << "Requests: " << served.submitted << ", Distinct Evaluations: " 
+                  << served.computed << ", Worker Passes: " << served.batches << std::endl;
+        std::cout << "R(720h): " << answers[1] * 100.0 << "%, R(1000h): " 
+                  << answers[0] * 100.0 << "%" << std::endl;
+        std::cout << std::endl;
+    }
+    
+    // Maintenance dispatch candidates
+    std::cout << "=== Top 5 At-Risk Sensors (1000h) ===" << std::endl;
+    for(const auto& risk : manager.topKAtRisk(5, 1000.0)) {
+        Sensor sensor = manager.getSensor(risk.slot);
+        std::cout << sensor.getId() << " (" << sensor.getTypeString() << "): "
+                  << risk.failureProbability * 100.0 << "% failure probability" << std::endl;
+    }
+    std::cout << std::endl;
+    
     // Queueing analysis
     QueueingModel queue(0.05, 0.15, 3);
     std::cout << "=== Maintenance Queue Analysis (M/M/3) ===" << std::endl;
@@ -393,29 +8093,144 @@ int main() {
     } else {
         std::cout << "Queue system unstable (rho >= 1)" << std::endl;
     }
+    std::cout << "Crews for <5 min Average Wait: " 
+              << QueueingModel::minimumServers(0.05, 0.15, 5.0 / 60.0) << std::endl;
+    std::cout << std::endl;
+
+    // What-if grid from one pass over the fleet
+    ScenarioGrid grid;
+    grid.rateMultipliers = {1.0, 1.2, 1.5};
+    grid.horizons = {720.0, 1000.0};
+    grid.crews = {1, 3};
+    grid.meanRepairTime = 1.0 / 0.15;
+    auto sweep = manager.sweepScenarios(grid);
+    std::cout << "=== Scenario Sweep (failure rates x1.0 / x1.2 / x1.5) ===" << std::endl;
+    for(std::size_t m = 0; m < sweep.multipliers; ++m) {
+        std::cout << "x" << grid.rateMultipliers[m] << ": R(720h) "
+                  << sweep.reliabilityAt(m, 0) * 100.0 << "%, R(1000h) "
+                  << sweep.reliabilityAt(m, 1) * 100.0 << "%, "
+                  << sweep.failureRate[m] * 1000.0 << " failures/1000h";
+        for(std::size_t c = 0; c < sweep.crewSizes; ++c) {
+            const QueueMetrics& q = sweep.queueAt(m, c);
+            std::cout << ", " << q.servers << " crew wait ";
+            if(q.avgWaitTime >= 0.0) {
+                std::cout << q.avgWaitTime * 60.0 << " min";
+            } else {
+                std::cout << "unbounded";
+            }
+        }
+        std::cout << std::endl;
+    }
     std::cout << std::endl;
     
     // Cascade risk analysis
-    auto cascade = manager.analyzeCascadeRisk();
+    const auto& cascade = snapshot.cascade;
     std::cout << "=== Cascade Failure Risk ===" << std::endl;
     std::cout << "Current Failures: " << cascade.currentFailures << std::endl;
     std::cout << std::setprecision(3);
     std::cout << "Cascade Risk Factor: " << cascade.riskFactor << std::endl;
     std::cout << "Expected Additional Failures: " 
               << cascade.expectedAdditional << std::endl;
-    std::cout << "Risk Level: " << cascade.riskLevel << std::endl;
+    std::cout << "Risk Level: " << riskLevelName(cascade.riskLevel) << std::endl;
+    
+    manager.setDependencyGraph(manager.buildProximityGraph(15.0, 0.3));
+    auto spread = manager.propagateCascade();
+    std::cout << "Dependency Edges: " << manager.getDependencyGraph().edges() << std::endl;
+    std::cout << "Topology Expected Additional Failures: " 
+              << spread.expectedAdditional << std::endl;
+    std::cout << std::endl;
+    
+    // Same crews with Erlang-2 repair times and type priorities
+    MaintenanceSimConfig des;
+    des.crews = 3;
+    des.meanRepairTime = 1.0 / 0.15;
+    des.service = ServiceDistribution::ERLANG;
+    des.serviceStages = 2;
+    auto sim = manager.simulateMaintenance(des);
+    std::cout << "=== Maintenance Queue Simulation (Erlang-2 repairs) ===" << std::endl;
+    std::cout << std::setprecision(3);
+    std::cout << "Events Simulated: " << sim.events << std::endl;
+    std::cout << "Throughput: " << sim.throughput << " repairs/hour" << std::endl;
+    std::cout << "Crew Utilization: " << sim.utilization * 100.0 << "%" << std::endl;
+    std::cout << "Average Queue Length: " << sim.meanQueueLength << std::endl;
+    std::cout << "Wait Time: mean " << sim.wait.mean * 60.0 << " minutes, P95 " 
+              << sim.wait.p95 * 60.0 << " minutes" << std::endl;
+    std::cout << std::endl;
+    
+    // Fleet lifetime simulation with the maintenance crews above
+    MonteCarloConfig mc;
+    mc.trials = 20000;
+    mc.horizon = 1000.0;
+    mc.crews = 3;
+    mc.meanRepairTime = 1.0 / 0.15;
+    auto lifetimes = manager.simulateLifetimes(mc);
+    std::cout << "=== Monte Carlo Fleet Lifetime (1000h, " << mc.trials << " trials) ===" << std::endl;
+    std::cout << std::setprecision(2);
+    std::cout << "Availability: mean " << lifetimes.availability.mean * 100.0 
+              << "%, P5 " << lifetimes.availability.p05 * 100.0 
+              << "%, P95 " << lifetimes.availability.p95 * 100.0 << "%" << std::endl;
+    std::cout << "Failures: mean " << lifetimes.failures.mean 
+              << ", P95 " << lifetimes.failures.p95 << std::endl;
+    std::cout << "Unrepaired at Horizon: mean " << lifetimes.backlog.mean 
+              << ", P99 " << lifetimes.backlog.p99 << std::endl;
+    std::cout << std::endl;
+    
+    // Refit the failure modes from a censored field history
+    LifetimeSample history = syntheticLifetimes(200000, 7);
+    auto refit = manager.fitCompetingRisks(history);
+    std::cout << "=== Lifetime Model Fit (competing risks, " << history.size() 
+              << " units, " << history.censored() << " censored) ===" << std::endl;
+    const char* modeNames[] = {"Infant Mortality", "Random", "Wear-out"};
+    for(std::size_t c = 0; c < refit.modes.size(); ++c) {
+        const auto& fit = refit.modes[c];
+        std::cout << std::setprecision(3);
+        std::cout << (c < 3 ? modeNames[c] : "Mode") << ": Weibull shape " << fit.model.shape()
+                  << std::setprecision(0) << ", scale " << fit.model.scale() << "h ("
+                  << fit.failures << " failures, " << fit.iterations << " iterations)" << std::endl;
+    }
+    std::cout << std::setprecision(2);
+    std::cout << "Fitted R(10000h): " << refit.model.reliability(10000.0) * 100.0 << "%" << std::endl;
+    std::cout << std::endl;
+    
+    // Replay the last day of one-minute telemetry into the health history,
+    // each sensor drifting down to its current health, kept at 12-bit precision
+    manager.enableHealthHistory(12);
+    const std::int64_t now = 1700000000;
+    std::mt19937 drift(7);
+    std::uniform_real_distribution<double> jitter(-0.5, 0.5);
+    const std::size_t fleetSize = manager.size();
+    std::vector<double> current(fleetSize), slope(fleetSize);
+    for(std::size_t i = 0; i < fleetSize; ++i) {
+        current[i] = manager.getSensor(i).getHealth();
+        slope[i] = (i % 5 == 0) ? 0.04 : 0.0;
+    }
+    for(std::int64_t minute = 1439; minute >= 0; --minute) {
+        for(std::size_t i = 0; i < fleetSize; ++i) {
+            double health = minute ? current[i] + slope[i] * minute + jitter(drift) : current[i];
+            manager.recordHealth(i, now - minute * 60, std::clamp(health, 0.0, 100.0));
+        }
+    }
+    const HealthHistory& healthLog = *manager.healthHistory();
+    std::cout << "=== Health History (24h, 1-minute samples, 12-bit) ===" << std::endl;
+    std::cout << "Samples Stored: " << healthLog.samples() << std::endl;
+    std::cout << std::setprecision(2);
+    std::cout << "Bytes per Sample: " 
+              << static_cast<double>(healthLog.memoryBytes()) / healthLog.samples() << std::endl;
+    std::cout << "Below 30% in Last 24h: " << manager.sensorsBelow(30.0, now - 86400, now).size() 
+              << " sensors" << std::endl;
+    std::cout << "Below 30% in Last 1h: " << manager.sensorsBelow(30.0, now - 3600, now).size() 
+              << " sensors" << std::endl;
     std::cout << std::endl;
     
     // Sample sensor analysis
-    auto sensors = manager.getSensors();
-    if(!sensors.empty()) {
-        auto sensor = sensors[0];
-        ExponentialModel expModel(sensor->getFailureRate());
-        ErlangModel erlModel(sensor->getKStages(), sensor->getFailureRate());
+    if(manager.size() > 0) {
+        Sensor sensor = manager.getSensor(0);
+        ExponentialModel expModel(sensor.getFailureRate());
+        ErlangModel erlModel(sensor.getKStages(), sensor.getFailureRate());
         
         std::cout << "=== Sample Sensor Analysis ===" << std::endl;
-        std::cout << "Sensor ID: " << sensor->getId() << std::endl;
-        std::cout << "Type: " << sensor->getTypeString() << std::endl;
+        std::cout << "Sensor ID: " << sensor.getId() << std::endl;
+        std::cout << "Type: " << sensor.getTypeString() << std::endl;
         std::cout << std::setprecision(4);
         std::cout << "Exponential R(500h): " 
                   << expModel.reliability(500.0) << std::endl;
@@ -429,5 +8244,12 @@ int main() {
     
     std::cout << "=== Analysis Complete ===" << std::endl;
     
+    if(printMetrics) {
+        std::cout << std::endl;
+        writePrometheus(std::cout);
+    }
+    
     return 0;
 }
+
+#endif // RELIABILITY_ENGINE_NO_MAIN
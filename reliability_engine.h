@@ -0,0 +1,121 @@
+/*
+ * Stable C ABI of the reliability engine, for Python (ctypes/NumPy) and
+ * other foreign callers. Build the shared library with
+ *
+ *   g++ -std=c++17 -O3 -shared -fPIC -pthread -DRELIABILITY_ENGINE_NO_MAIN \
+ *       -o libreliability.so reliability_engine.cpp
+ *
+ * Functions returning int report REL_OK or a negative REL_ERROR_* code.
+ * Column views point straight into the fleet store (or a mapped snapshot)
+ * and stay valid until the next mutation of that fleet. A fleet handle may
+ * be queried from several threads at once, but mutations need exclusive use.
+ */
+#ifndef RELIABILITY_ENGINE_H
+#define RELIABILITY_ENGINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define RELIABILITY_ABI_VERSION 1
+
+#if defined(_WIN32)
+#define RELIABILITY_API __declspec(dllexport)
+#else
+#define RELIABILITY_API __attribute__((visibility("default")))
+#endif
+
+#define REL_OK 0
+#define REL_ERROR_ARGUMENT (-1)
+#define REL_ERROR_IO (-2)
+#define REL_ERROR_FORMAT (-3)
+
+#define REL_SENSOR_TYPE_COUNT 3
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct rel_fleet rel_fleet;
+
+/* Read-only SoA column view. Sensors of type t occupy slots
+ * [type_begin[t], type_begin[t + 1]); the id of slot i is the id_length[i]
+ * bytes at id_pool + id_start[i]. */
+typedef struct rel_columns {
+    uint64_t count;
+    uint64_t type_begin[REL_SENSOR_TYPE_COUNT + 1];
+    const double* health;
+    const double* failure_rate;
+    const int32_t* k_stages;
+    const double* uptime_hours;
+    const uint8_t* types;
+    const double* loc_x;
+    const double* loc_y;
+    const double* loc_z;
+    const int32_t* queue_positions;
+    const uint32_t* id_start;
+    const uint32_t* id_length;
+    const char* id_pool;
+} rel_columns;
+
+typedef struct rel_stats {
+    int64_t total;
+    int64_t active;
+    int64_t warning;
+    int64_t failed;
+} rel_stats;
+
+RELIABILITY_API uint32_t rel_abi_version(void);
+
+/* Fleet lifetime and persistence */
+RELIABILITY_API rel_fleet* rel_fleet_create(void);
+RELIABILITY_API void rel_fleet_destroy(rel_fleet* fleet);
+RELIABILITY_API int rel_fleet_load(rel_fleet* fleet, const char* path);
+RELIABILITY_API int rel_fleet_save(const rel_fleet* fleet, const char* path);
+RELIABILITY_API int rel_fleet_open_snapshot(rel_fleet* fleet, const char* path);
+RELIABILITY_API int rel_fleet_save_snapshot(const rel_fleet* fleet, const char* path);
+RELIABILITY_API void rel_fleet_set_parallel(rel_fleet* fleet, int parallel);
+
+/* Bulk insert from caller-owned columns; ids are id_lengths[i] bytes each,
+ * packed in id_bytes. queue_positions may be NULL. */
+RELIABILITY_API int rel_fleet_add_sensors(rel_fleet* fleet, uint64_t count,
+                                          const double* health, const double* uptime_hours,
+                                          const double* failure_rate, const double* loc_x,
+                                          const double* loc_y, const double* loc_z,
+                                          const uint8_t* k_stages, const uint8_t* types,
+                                          const uint16_t* queue_positions,
+                                          const uint8_t* id_lengths, const char* id_bytes);
+RELIABILITY_API int rel_fleet_set_health(rel_fleet* fleet, const uint64_t* slots,
+                                         const double* health, uint64_t count);
+RELIABILITY_API uint64_t rel_fleet_size(const rel_fleet* fleet);
+RELIABILITY_API void rel_fleet_columns(const rel_fleet* fleet, rel_columns* out);
+
+/* Fleet queries */
+RELIABILITY_API double rel_fleet_mtbf(const rel_fleet* fleet);
+RELIABILITY_API double rel_fleet_mttf(const rel_fleet* fleet);
+RELIABILITY_API double rel_fleet_reliability(const rel_fleet* fleet, double horizon);
+RELIABILITY_API void rel_fleet_reliability_multi(const rel_fleet* fleet, const double* horizons,
+                                                 uint64_t count, double* out);
+RELIABILITY_API void rel_fleet_reliability_curve(const rel_fleet* fleet, double t0, double dt,
+                                                 uint64_t n, double* out);
+RELIABILITY_API void rel_fleet_stats(const rel_fleet* fleet, rel_stats* out);
+/* Writes up to k (slot, failure probability) pairs, worst first; returns
+ * the number written */
+RELIABILITY_API uint64_t rel_fleet_top_k_at_risk(const rel_fleet* fleet, uint64_t k,
+                                                 double horizon, uint64_t* slots,
+                                                 double* probabilities);
+
+/* Batch kernels over caller-owned arrays; out may alias an input */
+RELIABILITY_API void rel_exponential_reliability_batch(const double* rates, uint64_t n,
+                                                       double t, double* out);
+RELIABILITY_API void rel_erlang_reliability_batch(const int32_t* k_stages, const double* rates,
+                                                  uint64_t n, double t, double* out);
+RELIABILITY_API void rel_erlang_reliability_curve(int32_t k_stages, double rate, double t0,
+                                                  double dt, uint64_t n, double* out);
+RELIABILITY_API void rel_weibull_reliability_batch(const double* shapes, const double* scales,
+                                                   uint64_t n, double t, double* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RELIABILITY_ENGINE_H */
@@ -0,0 +1,430 @@
+import ctypes
+import os
+import sys
+from typing import Dict, List, Optional, Tuple
+
+import numpy as np
+
+
+ABI_VERSION = 1
+SENSOR_TYPES = ("traffic", "air_quality", "water_flow")
+
+_double_p = ctypes.POINTER(ctypes.c_double)
+_int32_p = ctypes.POINTER(ctypes.c_int32)
+_uint8_p = ctypes.POINTER(ctypes.c_uint8)
+_uint16_p = ctypes.POINTER(ctypes.c_uint16)
+_uint32_p = ctypes.POINTER(ctypes.c_uint32)
+_uint64_p = ctypes.POINTER(ctypes.c_uint64)
+
+
+class _Columns(ctypes.Structure):
+    """Mirror of rel_columns in reliability_engine.h"""
+    _fields_ = [
+        ("count", ctypes.c_uint64),
+        ("type_begin", ctypes.c_uint64 * (len(SENSOR_TYPES) + 1)),
+        ("health", _double_p),
+        ("failure_rate", _double_p),
+        ("k_stages", _int32_p),
+        ("uptime_hours", _double_p),
+        ("types", _uint8_p),
+        ("loc_x", _double_p),
+        ("loc_y", _double_p),
+        ("loc_z", _double_p),
+        ("queue_positions", _int32_p),
+        ("id_start", _uint32_p),
+        ("id_length", _uint32_p),
+        ("id_pool", ctypes.c_void_p),
+    ]
+
+
+class _Stats(ctypes.Structure):
+    """Mirror of rel_stats in reliability_engine.h"""
+    _fields_ = [
+        ("total", ctypes.c_int64),
+        ("active", ctypes.c_int64),
+        ("warning", ctypes.c_int64),
+        ("failed", ctypes.c_int64),
+    ]
+
+
+def _load_library(path: Optional[str] = None) -> ctypes.CDLL:
+    """Load libreliability.so from RELIABILITY_LIB, next to this file, or the loader path"""
+    if path is None:
+        path = os.environ.get("RELIABILITY_LIB")
+    if path is None:
+        local = os.path.join(os.path.dirname(os.path.abspath(__file__)), "libreliability.so")
+        path = local if os.path.exists(local) else "libreliability.so"
+    lib = ctypes.CDLL(path)
+
+    signatures = {
+        "rel_abi_version": (ctypes.c_uint32, []),
+        "rel_fleet_create": (ctypes.c_void_p, []),
+        "rel_fleet_destroy": (None, [ctypes.c_void_p]),
+        "rel_fleet_load": (ctypes.c_int, [ctypes.c_void_p, ctypes.c_char_p]),
+        "rel_fleet_save": (ctypes.c_int, [ctypes.c_void_p, ctypes.c_char_p]),
+        "rel_fleet_open_snapshot": (ctypes.c_int, [ctypes.c_void_p, ctypes.c_char_p]),
+        "rel_fleet_save_snapshot": (ctypes.c_int, [ctypes.c_void_p, ctypes.c_char_p]),
+        "rel_fleet_set_parallel": (None, [ctypes.c_void_p, ctypes.c_int]),
+        "rel_fleet_add_sensors": (ctypes.c_int, [
+            ctypes.c_void_p, ctypes.c_uint64,
+            _double_p, _double_p, _double_p, _double_p, _double_p, _double_p,
+            _uint8_p, _uint8_p, _uint16_p, _uint8_p, ctypes.c_char_p]),
+        "rel_fleet_set_health": (ctypes.c_int, [
+            ctypes.c_void_p, _uint64_p, _double_p, ctypes.c_uint64]),
+        "rel_fleet_size": (ctypes.c_uint64, [ctypes.c_void_p]),
+        "rel_fleet_columns": (None, [ctypes.c_void_p, ctypes.POINTER(_Columns)]),
+        "rel_fleet_mtbf": (ctypes.c_double, [ctypes.c_void_p]),
+        "rel_fleet_mttf": (ctypes.c_double, [ctypes.c_void_p]),
+        "rel_fleet_reliability": (ctypes.c_double, [ctypes.c_void_p, ctypes.c_double]),
+        "rel_fleet_reliability_multi": (None, [
+            ctypes.c_void_p, _double_p, ctypes.c_uint64, _double_p]),
+        "rel_fleet_reliability_curve": (None, [
+            ctypes.c_void_p, ctypes.c_double, ctypes.c_double, ctypes.c_uint64, _double_p]),
+        "rel_fleet_stats": (None, [ctypes.c_void_p, ctypes.POINTER(_Stats)]),
+        "rel_fleet_top_k_at_risk": (ctypes.c_uint64, [
+            ctypes.c_void_p, ctypes.c_uint64, ctypes.c_double, _uint64_p, _double_p]),
+        "rel_exponential_reliability_batch": (None, [
+            _double_p, ctypes.c_uint64, ctypes.c_double, _double_p]),
+        "rel_erlang_reliability_batch": (None, [
+            _int32_p, _double_p, ctypes.c_uint64, ctypes.c_double, _double_p]),
+        "rel_erlang_reliability_curve": (None, [
+            ctypes.c_int32, ctypes.c_double, ctypes.c_double, ctypes.c_double,
+            ctypes.c_uint64, _double_p]),
+        "rel_weibull_reliability_batch": (None, [
+            _double_p, _double_p, ctypes.c_uint64, ctypes.c_double, _double_p]),
+    }
+    for name, (restype, argtypes) in signatures.items():
+        fn = getattr(lib, name)
+        fn.restype = restype
+        fn.argtypes = argtypes
+
+    version = lib.rel_abi_version()
+    if version != ABI_VERSION:
+        raise RuntimeError(f"libreliability ABI version {version}, expected {ABI_VERSION}")
+    return lib
+
+
+_lib: Optional[ctypes.CDLL] = None
+
+
+def library() -> ctypes.CDLL:
+    """Shared library handle, loaded on first use"""
+    global _lib
+    if _lib is None:
+        _lib = _load_library()
+    return _lib
+
+
+def _input(values, dtype) -> np.ndarray:
+    """C-contiguous array of dtype; no copy when the caller's array already fits"""
+    return np.ascontiguousarray(values, dtype=dtype)
+
+
+def _integers(values, dtype, name: str) -> np.ndarray:
+    """_input for an integer column; values dtype cannot hold raise ValueError
+    instead of wrapping"""
+    values = np.asarray(values)
+    if values.dtype != dtype and values.size > 0:
+        info = np.iinfo(dtype)
+        if values.min() < info.min or values.max() > info.max:
+            raise ValueError(f"{name} must lie in [{info.min}, {info.max}]")
+    return _input(values, dtype)
+
+
+def _output(out: Optional[np.ndarray], n: int) -> np.ndarray:
+    """Caller-provided float64 output buffer, or a fresh one"""
+    if out is None:
+        return np.empty(n, dtype=np.float64)
+    if out.dtype != np.float64 or not out.flags.c_contiguous or out.size < n:
+        raise ValueError("out must be a C-contiguous float64 array of sufficient length")
+    return out
+
+
+def _ptr(array: np.ndarray, ptr_type):
+    return array.ctypes.data_as(ptr_type)
+
+
+def _view(pointer, n: int, dtype) -> np.ndarray:
+    """Read-only NumPy view over engine memory (no copy)"""
+    if n == 0 or not pointer:
+        return np.empty(0, dtype=dtype)
+    view = np.ctypeslib.as_array(pointer, shape=(n,))
+    view.flags.writeable = False
+    return view
+
+
+class Fleet:
+    """Fleet store in the native engine. Column views alias engine memory and
+    are invalidated by the next mutation (add_sensors, set_health, load)."""
+
+    def __init__(self):
+        self._lib = library()
+        self._handle = self._lib.rel_fleet_create()
+        if not self._handle:
+            raise MemoryError("rel_fleet_create failed")
+
+    def close(self):
+        if self._handle:
+            self._lib.rel_fleet_destroy(self._handle)
+            self._handle = None
+
+    def __del__(self):
+        self.close()
+
+    def __enter__(self) -> "Fleet":
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    def __len__(self) -> int:
+        return int(self._lib.rel_fleet_size(self._handle))
+
+    def _check(self, status: int, what: str):
+        if status != 0:
+            raise RuntimeError(f"{what} failed with status {status}")
+
+    def load(self, path: str):
+        """Append sensors from a binary columnar fleet file"""
+        self._check(self._lib.rel_fleet_load(self._handle, path.encode()), "load")
+
+    def save(self, path: str):
+        self._check(self._lib.rel_fleet_save(self._handle, path.encode()), "save")
+
+    def open_snapshot(self, path: str):
+        """Replace the fleet with a memory-mapped snapshot"""
+        self._check(self._lib.rel_fleet_open_snapshot(self._handle, path.encode()),
+                    "open_snapshot")
+
+    def save_snapshot(self, path: str):
+        self._check(self._lib.rel_fleet_save_snapshot(self._handle, path.encode()),
+                    "save_snapshot")
+
+    def set_parallel(self, parallel: bool = True):
+        self._lib.rel_fleet_set_parallel(self._handle, int(parallel))
+
+    def add_sensors(self, ids: List[str], types, health, uptime_hours, failure_rate,
+                    k_stages, locations, queue_positions=None):
+        """Bulk insert; types are indices into SENSOR_TYPES, locations is (n, 3).
+        IDs are stored UTF-8 encoded, at most 255 bytes each. Types and
+        k_stages must fit in uint8 and queue positions in uint16."""
+        n = len(ids)
+        encoded = [i.encode() for i in ids]
+        for sensor_id, raw in zip(ids, encoded):
+            if len(raw) > 255:
+                raise ValueError(f"sensor id {sensor_id[:32]!r} is {len(raw)} bytes "
+                                 "encoded; at most 255 are allowed")
+        id_lengths = _input([len(i) for i in encoded], np.uint8)
+        id_bytes = b"".join(encoded)
+        types = _integers(types, np.uint8, "types")
+        health = _input(health, np.float64)
+        uptime_hours = _input(uptime_hours, np.float64)
+        failure_rate = _input(failure_rate, np.float64)
+        k_stages = _integers(k_stages, np.uint8, "k_stages")
+        locations = np.asarray(locations, dtype=np.float64).reshape(n, 3)
+        loc_x = _input(locations[:, 0], np.float64)
+        loc_y = _input(locations[:, 1], np.float64)
+        loc_z = _input(locations[:, 2], np.float64)
+        queue = None
+        if queue_positions is not None:
+            queue = _integers(queue_positions, np.uint16, "queue_positions")
+        for column in (types, health, uptime_hours, failure_rate, k_stages, queue):
+            if column is not None and column.shape != (n,):
+                raise ValueError("column lengths must match ids")
+        status = self._lib.rel_fleet_add_sensors(
+            self._handle, n,
+            _ptr(health, _double_p), _ptr(uptime_hours, _double_p),
+            _ptr(failure_rate, _double_p),
+            _ptr(loc_x, _double_p), _ptr(loc_y, _double_p), _ptr(loc_z, _double_p),
+            _ptr(k_stages, _uint8_p), _ptr(types, _uint8_p),
+            _ptr(queue, _uint16_p) if queue is not None else None,
+            _ptr(id_lengths, _uint8_p), id_bytes)
+        self._check(status, "add_sensors")
+
+    def set_health(self, slots, health):
+        """Set health for many slots in one call"""
+        slots = _input(slots, np.uint64)
+        health = _input(health, np.float64)
+        if slots.shape != health.shape:
+            raise ValueError("slots and health must have the same length")
+        status = self._lib.rel_fleet_set_health(
+            self._handle, _ptr(slots, _uint64_p), _ptr(health, _double_p), slots.size)
+        self._check(status, "set_health")
+
+    def columns(self) -> Dict[str, np.ndarray]:
+        """Zero-copy read-only views of the SoA columns"""
+        c = _Columns()
+        self._lib.rel_fleet_columns(self._handle, ctypes.byref(c))
+        n = int(c.count)
+        return {
+            "health": _view(c.health, n, np.float64),
+            "failure_rate": _view(c.failure_rate, n, np.float64),
+            "k_stages": _view(c.k_stages, n, np.int32),
+            "uptime_hours": _view(c.uptime_hours, n, np.float64),
+            "types": _view(c.types, n, np.uint8),
+            "loc_x": _view(c.loc_x, n, np.float64),
+            "loc_y": _view(c.loc_y, n, np.float64),
+            "loc_z": _view(c.loc_z, n, np.float64),
+            "queue_positions": _view(c.queue_positions, n, np.int32),
+        }
+
+    def type_ranges(self) -> Dict[str, Tuple[int, int]]:
+        """Slot range [begin, end) of each sensor type"""
+        c = _Columns()
+        self._lib.rel_fleet_columns(self._handle, ctypes.byref(c))
+        return {name: (int(c.type_begin[t]), int(c.type_begin[t + 1]))
+                for t, name in enumerate(SENSOR_TYPES)}
+
+    def sensor_id(self, slot: int) -> str:
+        c = _Columns()
+        self._lib.rel_fleet_columns(self._handle, ctypes.byref(c))
+        if not 0 <= slot < c.count:
+            raise IndexError(slot)
+        return ctypes.string_at(c.id_pool + c.id_start[slot], c.id_length[slot]).decode()
+
+    def mtbf(self) -> float:
+        return self._lib.rel_fleet_mtbf(self._handle)
+
+    def mttf(self) -> float:
+        return self._lib.rel_fleet_mttf(self._handle)
+
+    def reliability(self, horizons, out: Optional[np.ndarray] = None):
+        """Fleet reliability at one horizon (float) or an array of horizons (one fused pass)"""
+        if np.isscalar(horizons):
+            return self._lib.rel_fleet_reliability(self._handle, float(horizons))
+        horizons = _input(horizons, np.float64)
+        out = _output(out, horizons.size)
+        self._lib.rel_fleet_reliability_multi(
+            self._handle, _ptr(horizons, _double_p), horizons.size, _ptr(out, _double_p))
+        return out[:horizons.size]
+
+    def reliability_curve(self, t0: float, dt: float, n: int,
+                          out: Optional[np.ndarray] = None) -> np.ndarray:
+        """Fleet reliability at t0 + i * dt for i in [0, n)"""
+        out = _output(out, n)
+        self._lib.rel_fleet_reliability_curve(self._handle, t0, dt, n, _ptr(out, _double_p))
+        return out[:n]
+
+    def stats(self) -> Dict[str, int]:
+        s = _Stats()
+        self._lib.rel_fleet_stats(self._handle, ctypes.byref(s))
+        return {"total": s.total, "active": s.active, "warning": s.warning, "failed": s.failed}
+
+    def top_k_at_risk(self, k: int, horizon: float) -> Tuple[np.ndarray, np.ndarray]:
+        """Slots and failure probabilities of the k sensors most likely to fail, worst first"""
+        slots = np.empty(k, dtype=np.uint64)
+        probabilities = np.empty(k, dtype=np.float64)
+        found = self._lib.rel_fleet_top_k_at_risk(
+            self._handle, k, horizon, _ptr(slots, _uint64_p), _ptr(probabilities, _double_p))
+        return slots[:found], probabilities[:found]
+
+
+def exponential_reliability(rates, t: float, out: Optional[np.ndarray] = None) -> np.ndarray:
+    """R(t) = e^(-λt) for each rate"""
+    rates = _input(rates, np.float64)
+    out = _output(out, rates.size)
+    library().rel_exponential_reliability_batch(
+        _ptr(rates, _double_p), rates.size, t, _ptr(out, _double_p))
+    return out[:rates.size]
+
+
+def erlang_reliability(k_stages, rates, t: float, out: Optional[np.ndarray] = None) -> np.ndarray:
+    """Erlang R(t) for each (k, λ) pair"""
+    k_stages = _input(k_stages, np.int32)
+    rates = _input(rates, np.float64)
+    if k_stages.shape != rates.shape:
+        raise ValueError("k_stages and rates must have the same length")
+    out = _output(out, rates.size)
+    library().rel_erlang_reliability_batch(
+        _ptr(k_stages, _int32_p), _ptr(rates, _double_p), rates.size, t, _ptr(out, _double_p))
+    return out[:rates.size]
+
+
+def erlang_reliability_curve(k: int, rate: float, t0: float, dt: float, n: int,
+                             out: Optional[np.ndarray] = None) -> np.ndarray:
+    """Erlang R(t0 + i * dt) for i in [0, n)"""
+    out = _output(out, n)
+    library().rel_erlang_reliability_curve(k, rate, t0, dt, n, _ptr(out, _double_p))
+    return out[:n]
+
+
+def weibull_reliability(shapes, scales, t: float, out: Optional[np.ndarray] = None) -> np.ndarray:
+    """Weibull R(t) = e^(-(t/η)^β) for each (β, η) pair"""
+    shapes = _input(shapes, np.float64)
+    scales = _input(scales, np.float64)
+    if shapes.shape != scales.shape:
+        raise ValueError("shapes and scales must have the same length")
+    out = _output(out, shapes.size)
+    library().rel_weibull_reliability_batch(
+        _ptr(shapes, _double_p), _ptr(scales, _double_p), shapes.size, t, _ptr(out, _double_p))
+    return out[:shapes.size]
+
+
+def _selftest() -> bool:
+    """Argument checks of the wrapper and of the engine behind it; prints one
+    line per check and returns False if any failed"""
+    failures = 0
+    columns = dict(types=[0, 1], health=[90.0, 50.0], uptime_hours=[1.0, 2.0],
+                   failure_rate=[1e-3, 2e-3], k_stages=[2, 3],
+                   locations=[[0.0, 0.0, 0.0], [1.0, 1.0, 1.0]])
+
+    def add(ids=("A", "B"), **overrides):
+        with Fleet() as fleet:
+            fleet.add_sensors(list(ids), **{**columns, **overrides})
+            return len(fleet)
+
+    def check(name: str, ok: bool):
+        nonlocal failures
+        print(f"{'ok  ' if ok else 'FAIL'} {name}")
+        failures += not ok
+
+    def raises(name: str, error, fn):
+        try:
+            fn()
+        except error:
+            check(name, True)
+        except Exception:
+            check(name, False)
+        else:
+            check(name, False)
+
+    check("add_sensors.valid", add() == 2)
+    raises("add_sensors.long_id", ValueError, lambda: add(ids=("x" * 256, "B")))
+    raises("add_sensors.column_length", ValueError, lambda: add(health=[90.0]))
+    raises("add_sensors.queue_length", ValueError, lambda: add(queue_positions=[1]))
+    raises("add_sensors.queue_range", ValueError, lambda: add(queue_positions=[70000, 1]))
+    raises("add_sensors.k_stages_range", ValueError, lambda: add(k_stages=[257, 1]))
+    raises("add_sensors.types_range", ValueError, lambda: add(types=[0, -1]))
+    raises("add_sensors.zero_stages", RuntimeError, lambda: add(k_stages=[2, 0]))
+    raises("add_sensors.unknown_type", RuntimeError, lambda: add(types=[0, len(SENSOR_TYPES)]))
+
+    def set_outside():
+        with Fleet() as fleet:
+            fleet.add_sensors(["A", "B"], **columns)
+            fleet.set_health([2], [50.0])
+
+    raises("set_health.slot_range", RuntimeError, set_outside)
+    print(f"self-test {'FAILED' if failures else 'passed'}: {failures} failing")
+    return failures == 0
+
+
+if __name__ == "__main__":
+    if "--selftest" in sys.argv[1:]:
+        sys.exit(0 if _selftest() else 1)
+    rng = np.random.default_rng(42)
+    n = 100000
+    with Fleet() as fleet:
+        fleet.add_sensors([f"S{i:06d}" for i in range(n)],
+                          types=rng.integers(0, 3, n),
+                          health=rng.uniform(0.0, 100.0, n),
+                          uptime_hours=rng.uniform(0.0, 5000.0, n),
+                          failure_rate=rng.uniform(1e-4, 1e-3, n),
+                          k_stages=rng.integers(1, 5, n),
+                          locations=rng.uniform(0.0, 1000.0, (n, 3)))
+        columns = fleet.columns()
+        print(f"Sensors: {len(fleet)}, mean health {columns['health'].mean():.4f}")
+        print(f"Fleet MTBF: {fleet.mtbf():.2f} hours")
+        print(f"Reliability at 100/500/1000 h: {fleet.reliability([100.0, 500.0, 1000.0])}")
+        slots, probabilities = fleet.top_k_at_risk(3, 1000.0)
+        for slot, p in zip(slots, probabilities):
+            print(f"  {fleet.sensor_id(int(slot))}: P(fail) = {p:.4f}")